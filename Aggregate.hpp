@@ -0,0 +1,205 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/*
+ * Reductions over contiguous arrays. float, double, int32_t and int64_t sums and float/double/int32_t min/max run
+ * in SIMD lanes (AVX2, or SSE2 for the float/double ones and the sums), everything else in a scalar loop with
+ * independent accumulators. Lanes are combined at the end, so floating point sums are reassociated and can differ
+ * from a front to back loop in the last bits. min/max of an empty array is undefined, callers check the count.
+ */
+namespace gdamn::data::aggregate {
+
+namespace detail {
+
+/* Folds whole vectors of lanes into two accumulators, then the lanes and the leftover elements with scalar */
+template<typename T, size_t lanes, typename V, typename Load, typename Combine, typename Scalar>
+inline T fold(const T* data, size_t count, V init, T start, Load load, Combine combine, Scalar scalar) {
+    V acc0 = init, acc1 = init;
+    size_t i = 0;
+    for(; i + 2 * lanes <= count; i += 2 * lanes) {
+        acc0 = combine(acc0, load(data + i));
+        acc1 = combine(acc1, load(data + i + lanes));
+    }
+    for(; i + lanes <= count; i += lanes) acc0 = combine(acc0, load(data + i));
+    acc0 = combine(acc0, acc1);
+
+    T spill[lanes];
+    std::memcpy(spill, &acc0, sizeof(spill));
+    T result = start;
+    for(size_t lane = 0; lane < lanes; lane++) result = scalar(result, spill[lane]);
+    for(; i < count; i++) result = scalar(result, data[i]);
+    return result;
+}
+
+template<typename T, typename Scalar>
+inline T scalar_fold(const T* data, size_t count, T start, Scalar scalar) {
+    T acc[4] = { start, start, start, start };
+    size_t i = 0;
+    for(; i + 4 <= count; i += 4)
+        for(size_t k = 0; k < 4; k++) acc[k] = scalar(acc[k], data[i + k]);
+    for(; i < count; i++) acc[0] = scalar(acc[0], data[i]);
+    return scalar(scalar(acc[0], acc[1]), scalar(acc[2], acc[3]));
+}
+
+template<typename T> inline T add(T a, T b)     { return (T)(a + b); }
+template<typename T> inline T lesser(T a, T b)  { return b < a ? b : a; }
+template<typename T> inline T greater(T a, T b) { return a < b ? b : a; }
+
+}
+
+template<typename T>
+T sum(const T* data, size_t count) {
+    using namespace detail;
+#if defined(__AVX2__)
+    if constexpr(std::is_same_v<T, float>)
+        return fold<T, 8>(data, count, _mm256_setzero_ps(), T(), [](const T* p) { return _mm256_loadu_ps(p); },
+                          [](__m256 a, __m256 b) { return _mm256_add_ps(a, b); }, add<T>);
+    if constexpr(std::is_same_v<T, double>)
+        return fold<T, 4>(data, count, _mm256_setzero_pd(), T(), [](const T* p) { return _mm256_loadu_pd(p); },
+                          [](__m256d a, __m256d b) { return _mm256_add_pd(a, b); }, add<T>);
+    if constexpr(std::is_integral_v<T> && sizeof(T) == 4)
+        return fold<T, 8>(data, count, _mm256_setzero_si256(), T(), [](const T* p) { return _mm256_loadu_si256((const __m256i*)p); },
+                          [](__m256i a, __m256i b) { return _mm256_add_epi32(a, b); }, add<T>);
+    if constexpr(std::is_integral_v<T> && sizeof(T) == 8)
+        return fold<T, 4>(data, count, _mm256_setzero_si256(), T(), [](const T* p) { return _mm256_loadu_si256((const __m256i*)p); },
+                          [](__m256i a, __m256i b) { return _mm256_add_epi64(a, b); }, add<T>);
+#elif defined(__SSE2__)
+    if constexpr(std::is_same_v<T, float>)
+        return fold<T, 4>(data, count, _mm_setzero_ps(), T(), [](const T* p) { return _mm_loadu_ps(p); },
+                          [](__m128 a, __m128 b) { return _mm_add_ps(a, b); }, add<T>);
+    if constexpr(std::is_same_v<T, double>)
+        return fold<T, 2>(data, count, _mm_setzero_pd(), T(), [](const T* p) { return _mm_loadu_pd(p); },
+                          [](__m128d a, __m128d b) { return _mm_add_pd(a, b); }, add<T>);
+    if constexpr(std::is_integral_v<T> && sizeof(T) == 4)
+        return fold<T, 4>(data, count, _mm_setzero_si128(), T(), [](const T* p) { return _mm_loadu_si128((const __m128i*)p); },
+                          [](__m128i a, __m128i b) { return _mm_add_epi32(a, b); }, add<T>);
+    if constexpr(std::is_integral_v<T> && sizeof(T) == 8)
+        return fold<T, 2>(data, count, _mm_setzero_si128(), T(), [](const T* p) { return _mm_loadu_si128((const __m128i*)p); },
+                          [](__m128i a, __m128i b) { return _mm_add_epi64(a, b); }, add<T>);
+#endif
+    return scalar_fold(data, count, T(), add<T>);
+}
+
+template<typename T>
+T min(const T* data, size_t count) {
+    using namespace detail;
+#if defined(__AVX2__)
+    if constexpr(std::is_same_v<T, float>)
+        return fold<T, 8>(data, count, _mm256_set1_ps(data[0]), data[0], [](const T* p) { return _mm256_loadu_ps(p); },
+                          [](__m256 a, __m256 b) { return _mm256_min_ps(a, b); }, lesser<T>);
+    if constexpr(std::is_same_v<T, double>)
+        return fold<T, 4>(data, count, _mm256_set1_pd(data[0]), data[0], [](const T* p) { return _mm256_loadu_pd(p); },
+                          [](__m256d a, __m256d b) { return _mm256_min_pd(a, b); }, lesser<T>);
+    if constexpr(std::is_same_v<T, int32_t>)
+        return fold<T, 8>(data, count, _mm256_set1_epi32(data[0]), data[0], [](const T* p) { return _mm256_loadu_si256((const __m256i*)p); },
+                          [](__m256i a, __m256i b) { return _mm256_min_epi32(a, b); }, lesser<T>);
+#elif defined(__SSE2__)
+    if constexpr(std::is_same_v<T, float>)
+        return fold<T, 4>(data, count, _mm_set1_ps(data[0]), data[0], [](const T* p) { return _mm_loadu_ps(p); },
+                          [](__m128 a, __m128 b) { return _mm_min_ps(a, b); }, lesser<T>);
+    if constexpr(std::is_same_v<T, double>)
+        return fold<T, 2>(data, count, _mm_set1_pd(data[0]), data[0], [](const T* p) { return _mm_loadu_pd(p); },
+                          [](__m128d a, __m128d b) { return _mm_min_pd(a, b); }, lesser<T>);
+#endif
+    return scalar_fold(data, count, data[0], lesser<T>);
+}
+
+template<typename T>
+T max(const T* data, size_t count) {
+    using namespace detail;
+#if defined(__AVX2__)
+    if constexpr(std::is_same_v<T, float>)
+        return fold<T, 8>(data, count, _mm256_set1_ps(data[0]), data[0], [](const T* p) { return _mm256_loadu_ps(p); },
+                          [](__m256 a, __m256 b) { return _mm256_max_ps(a, b); }, greater<T>);
+    if constexpr(std::is_same_v<T, double>)
+        return fold<T, 4>(data, count, _mm256_set1_pd(data[0]), data[0], [](const T* p) { return _mm256_loadu_pd(p); },
+                          [](__m256d a, __m256d b) { return _mm256_max_pd(a, b); }, greater<T>);
+    if constexpr(std::is_same_v<T, int32_t>)
+        return fold<T, 8>(data, count, _mm256_set1_epi32(data[0]), data[0], [](const T* p) { return _mm256_loadu_si256((const __m256i*)p); },
+                          [](__m256i a, __m256i b) { return _mm256_max_epi32(a, b); }, greater<T>);
+#elif defined(__SSE2__)
+    if constexpr(std::is_same_v<T, float>)
+        return fold<T, 4>(data, count, _mm_set1_ps(data[0]), data[0], [](const T* p) { return _mm_loadu_ps(p); },
+                          [](__m128 a, __m128 b) { return _mm_max_ps(a, b); }, greater<T>);
+    if constexpr(std::is_same_v<T, double>)
+        return fold<T, 2>(data, count, _mm_set1_pd(data[0]), data[0], [](const T* p) { return _mm_loadu_pd(p); },
+                          [](__m128d a, __m128d b) { return _mm_max_pd(a, b); }, greater<T>);
+#endif
+    return scalar_fold(data, count, data[0], greater<T>);
+}
+
+/* Mean without overflowing narrow types: integers are summed in 64 bits, float in double, wider floats as they are */
+template<typename T>
+double average(const T* data, size_t count) {
+    if(count == 0) return 0.0;
+    if constexpr(std::is_same_v<T, float>) {
+        double acc[4] = {};
+        size_t i = 0;
+        for(; i + 4 <= count; i += 4)
+            for(size_t k = 0; k < 4; k++) acc[k] += (double)data[i + k];
+        for(; i < count; i++) acc[0] += (double)data[i];
+        return ((acc[0] + acc[1]) + (acc[2] + acc[3])) / (double)count;
+    } else if constexpr(std::is_floating_point_v<T>) {
+        return (double)sum(data, count) / (double)count;
+    } else {
+        using Wide = std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>;
+        Wide total = 0;
+        for(size_t i = 0; i < count; i++) total += (Wide)data[i];
+        return (double)total / (double)count;
+    }
+}
+
+/*
+ * Open-addressed set of indices into an array the caller owns, for distinct and group_by. It is sized once for the
+ * most keys it can be asked about (the input length), so it never rehashes. Keys are compared through key_at(index).
+ */
+template<typename K, typename Hash = std::hash<K>>
+class KeyIndex {
+private:
+    struct Slot {
+        size_t hash;
+        size_t index;   /* Index + 1, 0 when free */
+    };
+
+public:
+    explicit KeyIndex(size_t max_keys) {
+        size_t size = 16;
+        while(size * 3 < max_keys * 4) size *= 2; /* Load factor <= 0.75 */
+        slots = new Slot[size]();
+        table_mask = size - 1;
+    }
+
+    ~KeyIndex() { delete[] slots; }
+
+    KeyIndex(const KeyIndex&) = delete;
+    KeyIndex& operator=(const KeyIndex&) = delete;
+
+    /* Index of the key equal to key, or next after recording key at next */
+    template<typename KeyAt>
+    size_t find_or_add(const K& key, size_t next, KeyAt&& key_at) {
+        size_t hash = Hash()(key) * 0x9E3779B97F4A7C15ull; /* std::hash of integers is the identity, spread it */
+        for(size_t i = (hash >> 32) & table_mask;; i = (i + 1) & table_mask) {
+            Slot& slot = slots[i];
+            if(slot.index == 0) {
+                slot = { hash, next + 1 };
+                return next;
+            }
+            if(slot.hash == hash && key_at(slot.index - 1) == key) return slot.index - 1;
+        }
+    }
+
+private:
+    Slot*   slots = nullptr;
+    size_t  table_mask = 0;
+};
+
+}
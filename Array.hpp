@@ -3,7 +3,6 @@
 #include <initializer_list>
 #include <limits>
 #include <cstring>
-#include <functional>
 #include "Enumerable.hpp"
 
 namespace gdamn::data {
@@ -19,8 +18,10 @@ public:
     Array<T, n>& operator=(Array<T, n>& other);
     Array<T, n>& operator=(Array<T, n>&& other);
 
-    void for_each(std::function<void(T&)> call_back);
-    auto where(std::function<bool(const T&)> match_func);
+    template<Visitor<T&> F>
+    void for_each(F call_back);
+    template<Predicate<const T&> F>
+    auto where(F match_func);
 
     bool contains(T& key);
     bool contains(T&& key);
@@ -136,13 +137,15 @@ Array<T, n>& Array<T, n>::operator=(Array<T, n>&& other) {
 }
 
 template<typename T, size_t n>
-void Array<T, n>::for_each(std::function<void(T&)> call_back) {
+template<Visitor<T&> F>
+void Array<T, n>::for_each(F call_back) {
     for(auto& val : *this)
         call_back(val);
 }
 
 template<typename T, size_t n>
-auto Array<T, n>::where(std::function<bool(const T&)> match_func) {
+template<Predicate<const T&> F>
+auto Array<T, n>::where(F match_func) {
     Enumerable<T> enumerable;
     for(size_t i = 0; i < len(); i++)
         if(match_func(data[i])) enumerable.insert(data[i]);
@@ -0,0 +1,14 @@
+#pragma once
+#include <concepts>
+#include <type_traits>
+
+namespace gdamn::data {
+
+/* Callables taken by the container algorithms, as template parameters so the call inlines */
+template<typename F, typename... Args>
+concept Visitor = std::invocable<F&, Args...>;
+
+template<typename F, typename... Args>
+concept Predicate = std::invocable<F&, Args...> && std::convertible_to<std::invoke_result_t<F&, Args...>, bool>;
+
+}
@@ -3,43 +3,64 @@
 #include <cstdint>
 #include <memory>
 #include <limits>
-#include <functional>
+#include <new>
 #include <cstring>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
 #include "Enumerable.hpp"
 
 namespace gdamn::data {
 
-template<typename T, size_t n>
+template<typename T, size_t chunk_bytes>
 class Deque;
 
 namespace {
 
-template<typename T, size_t n = 12>
+/* Header and payload share one allocation, slots are raw storage constructed in place by the owning Deque */
+template<typename T, size_t n>
 struct Chunk {
-    Chunk()  { n_left = n; }
-    ~Chunk() { delete[] data; }
+    T* data() { return std::launder(reinterpret_cast<T*>(storage)); }
 private:
-    friend Deque<T, n>;
-    size_t n_left = n;
-    T* data = nullptr;
+    template<typename, size_t> friend class gdamn::data::Deque;
+    Chunk<T, n>* next_spare = nullptr;
+    alignas(T) unsigned char storage[n * sizeof(T)];
 };
 
+/* Largest power of two that keeps a chunk within chunk_bytes, at least one element */
+constexpr size_t chunk_capacity(size_t elem_size, size_t chunk_bytes) {
+    size_t cap = 1;
+    while(cap * 2 * elem_size <= chunk_bytes) cap *= 2;
+    return cap;
+}
+
 }
 
-template<typename T, size_t n = 12>
+template<typename T, size_t chunk_bytes = 1024>
 class Deque {
 public:
+    /* Elements per chunk; a power of two so indexing is a shift and a mask */
+    static constexpr size_t n = chunk_capacity(sizeof(T), chunk_bytes);
+
     Deque();
     Deque(Deque&);
 
     Deque(Deque&& other) {
         this->chunks = other.chunks;
-        this->curr_chunk = other.curr_chunk;
+        this->map_cap = other.map_cap;
+        this->map_begin = other.map_begin;
         this->n_chunks = other.n_chunks;
+        this->front_offset = other.front_offset;
         this->n_nodes = other.n_nodes;
+        this->spares = other.spares;
+        this->n_spares = other.n_spares;
         other.chunks = nullptr;
-        other.curr_chunk = 0;
+        other.spares = nullptr;
+        other.n_spares = 0;
+        other.map_cap = 0;
+        other.map_begin = 0;
         other.n_chunks = 0;
+        other.front_offset = 0;
         other.n_nodes = 0;
     }
 
@@ -50,7 +71,7 @@ public:
     public:
         Iterator() {}
 
-        Iterator(Iterator& itr) {
+        Iterator(const Iterator& itr) {
             this->index = itr.index;
             this->ref = itr.ref;
         }
@@ -62,7 +83,7 @@ public:
             itr.ref = nullptr;
         }
 
-        Iterator& operator=(Iterator& other) {
+        Iterator& operator=(const Iterator& other) {
             this->index = other.index;
             this->ref = other.ref;
             return *this;
@@ -109,13 +130,13 @@ public:
         }
 
     private:
-        Iterator(Deque<T, n>* ref, size_t index = 0) { 
+        Iterator(Deque<T, chunk_bytes>* ref, size_t index = 0) { 
             this->index = index;
             this->ref = ref; 
         }
-        Deque<T, n>* ref = nullptr;
+        Deque<T, chunk_bytes>* ref = nullptr;
         size_t index = 0;
-        friend Deque<T, n>;
+        friend Deque<T, chunk_bytes>;
     };
 
     void insert(T& val);
@@ -125,18 +146,36 @@ public:
     void insert_back(T& val);
     void insert_back(T&& val);
 
-/* Under construction */
+    /* Constructs the value directly inside the chunk storage */
+    template<typename... Args>
+    T& emplace_front(Args&&... args);
+    template<typename... Args>
+    T& emplace_back(Args&&... args);
+    template<typename... Args>
+    Iterator emplace(Iterator where, Args&&... args); /* Inserts in front of where */
 
     void remove(T& val);
     void remove(T&& val);
     void remove_all(T& val);
     void remove_all(T&& val);
     void remove(Iterator where);
+    template<Predicate<const T&> F>
+    void remove_if(F match_func);
+    void pop_front();
+    void pop_back();
+
+    /* Copies count elements from src in one go, filling whole chunks at a time */
+    void append(const T* src, size_t count);
+    void prepend(const T* src, size_t count);
 
-/* End Constructrion*/
+    /* Calls fn(T* data, size_t count) once per contiguous chunk run, front to back. Returning false stops the walk */
+    template<typename F>
+    void for_each_segment(F&& fn);
 
-    void for_each(std::function<void(T&)> call_back);
-    Enumerable<T> where(std::function<bool(const T&)> match_func);
+    template<Visitor<T&> F>
+    void for_each(F call_back);
+    template<Predicate<const T&> F>
+    Enumerable<T> where(F match_func);
 
     bool contains(T& key);
     bool contains(T&& key);
@@ -147,8 +186,8 @@ public:
     Iterator first_or_default(T&&);
 
     T& operator[](size_t i) {
-        i += chunks[0]->n_left;
-        return chunks[i / n]->data[i % n];
+        i += front_offset;
+        return chunk_at(i / n)->data()[i % n];
     }
 
     T& first();
@@ -157,229 +196,446 @@ public:
     Iterator begin()    { return Iterator(this); }
     Iterator end()      { return Iterator(this, len()); }
 
-    void realign_chunks(const size_t num) {
-        auto new_chunks = new Chunk<T, n>*[n_chunks + num]; /* Fix the memory leak it'll cause */
-        std::memcpy(new_chunks, chunks, n_chunks * sizeof(Chunk<T, n>*)); /* Prev upper bound */
-        for(size_t i = 0; i < num; i++) {
-            new_chunks[n_chunks + i] = new Chunk<T, n>();
-            new_chunks[n_chunks + i]->data = new T[n];
-        }
-        operator delete[](chunks);
-        chunks = new_chunks;
-        n_chunks += num;
-    }
-
-public:
+private:
+    /* k-th chunk counted from the front of the ring */
+    Chunk<T, n>*& chunk_at(size_t k) { return chunks[(map_begin + k) & (map_cap - 1)]; }
+
+    void grow_map();
+    void push_chunk_front();
+    void push_chunk_back();
+    void pop_chunk_front();
+    void trim_back_chunks();
+    Chunk<T, n>* acquire_chunk();
+    void release_chunk(Chunk<T, n>* chunk);
+
+    void shift_down(size_t from, size_t to);
+    void shift_up(size_t from, size_t to);
+    void erase_at(size_t index);
+    size_t find_index(const T& key);
+    template<typename F>
+    void compact(F&& remove_func);
+
+    /*
+     * The chunk map is a ring of map_cap (power of two) slots, n_chunks of them starting at map_begin are in use.
+     * Elements start front_offset slots into the first chunk, so both ends grow without moving any chunk pointer.
+     */
+    Chunk<T, n>**   chunks = nullptr;
+    size_t          map_cap = 0;
+    size_t          map_begin = 0;
     size_t          n_chunks = 0;
+    size_t          front_offset = 0;
     size_t          n_nodes = 0;
-    size_t          curr_chunk = 1;
-    Chunk<T, n>**   chunks = nullptr;
 
-    friend          typename Deque<T>::Iterator;
+    /* Emptied chunks are parked here, so steady push back / pop front traffic doesn't reach malloc */
+    static constexpr size_t max_spares = 4;
+    Chunk<T, n>*    spares = nullptr;
+    size_t          n_spares = 0;
+
+    friend          Iterator;
 };
 
-template<typename T, size_t n>
-Deque<T, n>::Deque() {
-    chunks = new Chunk<T, n>*[2]; /* Front chunk and first back chunk */
-    chunks[0] = new Chunk<T, n>();
-    chunks[0]->data = new T[n];
-    
-    std::memset(chunks[0]->data, 0, sizeof(T) * n);
-    chunks[1] = new Chunk<T, n>();
-    chunks[1]->data = new T[n];
-    std::memset(chunks[1]->data, 0, sizeof(T) * n);
-    n_chunks += 2;
+template<typename T, size_t chunk_bytes>
+Deque<T, chunk_bytes>::Deque() {} /* Chunks and the map are allocated on first insertion */
+
+template<typename T, size_t chunk_bytes>
+Deque<T, chunk_bytes>::~Deque() {
+    while(spares != nullptr) {
+        auto del = spares;
+        spares = spares->next_spare;
+        delete del;
+    }
+
+    if(chunks == nullptr) return; /* Empty or moved from */
+    for(size_t i = 0; i < n_nodes; i++) (*this)[i].~T();
+    for(size_t i = 0; i < n_chunks; i++) delete chunk_at(i);
+    delete[] chunks;
 }
 
-template<typename T, size_t n>
-Deque<T, n>::~Deque() {
-    for(size_t i = 0; i < n_chunks; i++) delete chunks[i];
+template<typename T, size_t chunk_bytes>
+Chunk<T, Deque<T, chunk_bytes>::n>* Deque<T, chunk_bytes>::acquire_chunk() {
+    if(spares == nullptr) return new Chunk<T, n>; /* Default-init: only next_spare is set, slots stay raw */
+    auto chunk = spares;
+    spares = spares->next_spare;
+    n_spares--;
+    return chunk;
+}
+
+template<typename T, size_t chunk_bytes>
+void Deque<T, chunk_bytes>::release_chunk(Chunk<T, n>* chunk) {
+    if(n_spares == max_spares) {
+        delete chunk;
+        return;
+    }
+    chunk->next_spare = spares;
+    spares = chunk;
+    n_spares++;
+}
+
+template<typename T, size_t chunk_bytes>
+void Deque<T, chunk_bytes>::grow_map() {
+    /* Double the ring and unroll it so the chunks start at slot 0 again */
+    size_t new_cap = map_cap == 0 ? 8 : map_cap * 2;
+    auto new_chunks = new Chunk<T, n>*[new_cap];
+    for(size_t i = 0; i < n_chunks; i++) new_chunks[i] = chunk_at(i);
     delete[] chunks;
+    chunks = new_chunks;
+    map_cap = new_cap;
+    map_begin = 0;
 }
 
-template<typename T, size_t n>
-void Deque<T, n>::insert(T& val) {
-    // Make sure that enough reserve is left
-    if(chunks[curr_chunk]->n_left == 0)
-    {
-        realign_chunks(1);
-        curr_chunk++;
+template<typename T, size_t chunk_bytes>
+void Deque<T, chunk_bytes>::push_chunk_front() {
+    if(n_chunks == map_cap) grow_map();
+    map_begin = (map_begin + map_cap - 1) & (map_cap - 1);
+    chunks[map_begin] = acquire_chunk();
+    n_chunks++;
+    front_offset += n;
+}
+
+template<typename T, size_t chunk_bytes>
+void Deque<T, chunk_bytes>::push_chunk_back() {
+    if(n_chunks == map_cap) grow_map();
+    chunk_at(n_chunks) = acquire_chunk();
+    n_chunks++;
+}
+
+template<typename T, size_t chunk_bytes>
+void Deque<T, chunk_bytes>::pop_chunk_front() {
+    release_chunk(chunk_at(0));
+    map_begin = (map_begin + 1) & (map_cap - 1);
+    n_chunks--;
+    front_offset -= n;
+}
+
+template<typename T, size_t chunk_bytes>
+void Deque<T, chunk_bytes>::trim_back_chunks() {
+    /* Release back chunks that no longer hold a single element */
+    while(n_chunks > 0 && (n_chunks - 1) * n >= front_offset + n_nodes) {
+        release_chunk(chunk_at(n_chunks - 1));
+        n_chunks--;
     }
-    size_t index = n - chunks[curr_chunk]->n_left;
-    chunks[curr_chunk]->n_left--;
-    chunks[curr_chunk]->data[index] = val;
-    n_nodes++;
 }
 
-template<typename T, size_t n>
-void Deque<T, n>::insert(T&& val) {
-    if(chunks[curr_chunk]->n_left == 0) 
-    {
-        realign_chunks(1);
-        curr_chunk++;
+/* Moves [from + 1, to) onto [from, to - 1), one contiguous chunk run at a time */
+template<typename T, size_t chunk_bytes>
+void Deque<T, chunk_bytes>::shift_down(size_t from, size_t to) {
+    size_t dst = front_offset + from;
+    size_t dst_end = front_offset + to - 1;
+
+    while(dst < dst_end) {
+        size_t slot = dst % n;
+        size_t run = std::min(dst_end - dst, n - slot);
+        T* data = chunk_at(dst / n)->data();
+
+        if(slot + run < n) {
+            std::move(data + slot + 1, data + slot + run + 1, data + slot);
+        } else { /* The last source element sits at the start of the next chunk */
+            std::move(data + slot + 1, data + n, data + slot);
+            data[n - 1] = std::move(chunk_at(dst / n + 1)->data()[0]);
+        }
+        dst += run;
     }
-    size_t index = n - chunks[curr_chunk]->n_left;
-    chunks[curr_chunk]->n_left--;
-    chunks[curr_chunk]->data[index] = std::move(val);
-    n_nodes++;
 }
 
-template<typename T, size_t n>
-void Deque<T, n>::insert_back(T& val) {
-    insert(val);
+/* Moves [from, to) onto [from + 1, to + 1), walking the chunk runs back to front */
+template<typename T, size_t chunk_bytes>
+void Deque<T, chunk_bytes>::shift_up(size_t from, size_t to) {
+    size_t dst_begin = front_offset + from + 1;
+    size_t dst_end = front_offset + to + 1;
+
+    while(dst_end > dst_begin) {
+        size_t slot_end = (dst_end - 1) % n + 1;
+        size_t run = std::min(dst_end - dst_begin, slot_end);
+        T* data = chunk_at((dst_end - 1) / n)->data();
+        size_t slot = slot_end - run;
+
+        if(slot > 0) {
+            std::move_backward(data + slot - 1, data + slot_end - 1, data + slot_end);
+        } else { /* The first source element sits at the end of the previous chunk */
+            std::move_backward(data, data + slot_end - 1, data + slot_end);
+            data[0] = std::move(chunk_at((dst_end - 1) / n - 1)->data()[n - 1]);
+        }
+        dst_end -= run;
+    }
 }
 
-template<typename T, size_t n>
-void Deque<T, n>::insert_back(T&& val) {
-    insert(val);
+/* Closes the gap from whichever end is nearer, so at most half of the elements move */
+template<typename T, size_t chunk_bytes>
+void Deque<T, chunk_bytes>::erase_at(size_t index) {
+    if(index < n_nodes / 2) {
+        shift_up(0, index);
+        (*this)[0].~T();
+        front_offset++;
+        n_nodes--;
+        if(front_offset == n) pop_chunk_front();
+    } else {
+        shift_down(index, n_nodes);
+        (*this)[n_nodes - 1].~T();
+        n_nodes--;
+        trim_back_chunks();
+    }
 }
 
-template<typename T, size_t n>
-void Deque<T, n>::insert_front(T& val) {
-    if(chunks[0]->n_left == 0)
-    {
-        /* Allocate new front-chunk and make current part of actual chunk-chain */
-        auto new_chunk = new Chunk<T, n>*[n_chunks + 1];
-        std::memcpy(new_chunk + 1, chunks, sizeof(Chunk<T, n>*) * n_chunks);
-        operator delete[](chunks);
-        chunks = new_chunk;
-        chunks[0] = new Chunk<T, n>();
-        chunks[0]->data = new T[n];
-        n_chunks++;
+/* Single pass: survivors are moved down over the removed ones, the leftover tail is destroyed once */
+template<typename T, size_t chunk_bytes>
+template<typename F>
+void Deque<T, chunk_bytes>::compact(F&& remove_func) {
+    size_t kept = 0;
+    for(size_t i = 0; i < n_nodes; i++) {
+        T& val = (*this)[i];
+        if(remove_func(val)) continue;
+        if(kept != i) (*this)[kept] = std::move(val);
+        kept++;
     }
 
-    chunks[0]->n_left--;
-    chunks[0]->data[chunks[0]->n_left] = val;
+    for(size_t i = kept; i < n_nodes; i++) (*this)[i].~T();
+    n_nodes = kept;
+    trim_back_chunks();
+}
+
+template<typename T, size_t chunk_bytes>
+void Deque<T, chunk_bytes>::insert(T& val) {
+    emplace_back(val);
+}
+
+template<typename T, size_t chunk_bytes>
+void Deque<T, chunk_bytes>::insert(T&& val) {
+    emplace_back(std::move(val));
+}
+
+template<typename T, size_t chunk_bytes>
+void Deque<T, chunk_bytes>::insert_back(T& val) {
+    emplace_back(val);
+}
+
+template<typename T, size_t chunk_bytes>
+void Deque<T, chunk_bytes>::insert_back(T&& val) {
+    emplace_back(std::move(val));
+}
+
+template<typename T, size_t chunk_bytes>
+void Deque<T, chunk_bytes>::insert_front(T& val) {
+    emplace_front(val);
+}
+
+template<typename T, size_t chunk_bytes>
+void Deque<T, chunk_bytes>::insert_front(T&& val) {
+    emplace_front(std::move(val));
+}
+
+template<typename T, size_t chunk_bytes>
+template<typename... Args>
+T& Deque<T, chunk_bytes>::emplace_back(Args&&... args) {
+    size_t index = front_offset + n_nodes;
+    if(index == n_chunks * n) push_chunk_back(); /* Back chunk is full */
+
+    T* slot = new (&chunk_at(index / n)->data()[index % n]) T(std::forward<Args>(args)...);
     n_nodes++;
+    return *slot;
 }
 
-template<typename T, size_t n>
-void Deque<T, n>::insert_front(T&& val) {
-    if(chunks[0]->n_left == 0)
-    {
-        /* Allocate new front-chunk and make current part of actual chunk-chain */
-        auto new_chunk = new Chunk<T, n>*[n_chunks + 1];
-        std::memcpy(new_chunk + 1, chunks, sizeof(Chunk<T, n>) * n_chunks);
-        operator delete(chunks);
-        chunks = new_chunk;
-        chunks[0] = new Chunk<T, n>();
-        chunks[0]->data = new T[n];
-    }
+template<typename T, size_t chunk_bytes>
+template<typename... Args>
+T& Deque<T, chunk_bytes>::emplace_front(Args&&... args) {
+    if(front_offset == 0) push_chunk_front(); /* Front chunk is full */
 
-    chunks[0]->n_left--;
-    chunks[0]->data[chunks[0]->n_left] = std::move(val);
+    T* slot = new (&chunk_at(0)->data()[front_offset - 1]) T(std::forward<Args>(args)...);
+    front_offset--;
     n_nodes++;
+    return *slot;
 }
 
-/* Pretty likely to crash */
-template<typename T, size_t n>
-void Deque<T, n>::remove(T& key) {
-    size_t index = find(key);
-    if(index == std::numeric_limits<size_t>::max()) return; /* Key doesn't exist in chunks */
+template<typename T, size_t chunk_bytes>
+template<typename... Args>
+typename Deque<T, chunk_bytes>::Iterator Deque<T, chunk_bytes>::emplace(Iterator where, Args&&... args) {
+    size_t index = where.index;
+    if(index == 0) {
+        emplace_front(std::forward<Args>(args)...);
+        return begin();
+    }
+    if(index >= len()) {
+        emplace_back(std::forward<Args>(args)...);
+        return Iterator(this, len() - 1);
+    }
 
-    auto temp = new T[len() - (index + 1)]; /* Copy everything into temporary storage */
-    size_t j = 0;
-    for(size_t i = index + 1; i < len(); i++, j++)
-        temp[j] = (*this)[i];
-    for(size_t i = index, j = 0; j < (len() - (index + 1)); i++, j++) {
-        (*this)[i] = temp[j]; 
+    /* The value has to land between live elements, so it is built first and the nearer end is shifted outwards */
+    T value(std::forward<Args>(args)...);
+    if(index < n_nodes / 2) {
+        emplace_front(std::move(first()));
+        shift_down(1, index + 1);
+    } else {
+        emplace_back(std::move(last()));
+        shift_up(index, len() - 2);
     }
-    n_nodes--;
-    chunks[n_chunks - 1]->n_left++; /* TODO: Consider by realign_chunk pre-allocated chunks */
-    operator delete[](temp);
+    (*this)[index] = std::move(value);
+    return Iterator(this, index);
 }
 
-template<typename T, size_t n>
-void Deque<T, n>::remove(T&& key) {
+template<typename T, size_t chunk_bytes>
+void Deque<T, chunk_bytes>::remove(T& key) {
     size_t index = find(key);
     if(index == std::numeric_limits<size_t>::max()) return; /* Key doesn't exist in chunks */
+    erase_at(index);
+}
 
-    /* TODO: copy per chunk && std::memcpy */
-    auto temp = new T[len() - (index + 1)]; /* Copy everything into temporary storage */
-    size_t j = 0;
-    for(size_t i = index + 1; i < len(); i++, j++)
-        temp[j] = (*this)[i];
-    for(size_t i = index, j = 0; j < (len() - (index + 1)); i++, j++) {
-        (*this)[i] = temp[j]; 
-    }
-    n_nodes--;
-    chunks[n_chunks - 1]->n_left++; /* TODO: Consider by realign_chunk pre-allocated chunks */
-    operator delete[](temp);
+template<typename T, size_t chunk_bytes>
+void Deque<T, chunk_bytes>::remove(T&& key) {
+    size_t index = find(key);
+    if(index == std::numeric_limits<size_t>::max()) return; /* Key doesn't exist in chunks */
+    erase_at(index);
 }
 
-template<typename T, size_t n>
-void Deque<T, n>::remove(Iterator key) {
+template<typename T, size_t chunk_bytes>
+void Deque<T, chunk_bytes>::remove(Iterator key) {
     if(key.index >= len()) return; /* Key doesn't exist in chunks */
-    auto index = key.index; // Everything checks out; ...
-    
-    auto temp = new T[len() - (index + 1)]; /* Copy everything into temporary storage */
-    size_t j = 0;
-    for(size_t i = index + 1; i < len(); i++, j++)
-        temp[j] = (*this)[i];
-    j = 0;
-    for(size_t i = index; j < (len() - (index + 1)); i++, j++) {
-        (*this)[i] = temp[j]; 
+    erase_at(key.index);
+}
+
+template<typename T, size_t chunk_bytes>
+void Deque<T, chunk_bytes>::remove_all(T& key) {
+    compact([&key](const T& val) { return val == key; });
+}
+
+template<typename T, size_t chunk_bytes>
+void Deque<T, chunk_bytes>::remove_all(T&& key) {
+    compact([&key](const T& val) { return val == key; });
+}
+
+template<typename T, size_t chunk_bytes>
+template<Predicate<const T&> F>
+void Deque<T, chunk_bytes>::remove_if(F match_func) {
+    compact(match_func);
+}
+
+template<typename T, size_t chunk_bytes>
+void Deque<T, chunk_bytes>::pop_front() {
+    if(n_nodes == 0) return;
+    erase_at(0);
+}
+
+template<typename T, size_t chunk_bytes>
+void Deque<T, chunk_bytes>::pop_back() {
+    if(n_nodes == 0) return;
+    erase_at(n_nodes - 1);
+}
+
+template<typename T, size_t chunk_bytes>
+void Deque<T, chunk_bytes>::append(const T* src, size_t count) {
+    while(count > 0) {
+        size_t index = front_offset + n_nodes;
+        if(index == n_chunks * n) push_chunk_back();
+
+        size_t run = std::min(count, n - index % n);
+        T* dst = chunk_at(index / n)->data() + index % n;
+        if constexpr(std::is_trivially_copyable_v<T>)   std::memcpy(dst, src, sizeof(T) * run);
+        else                                            std::uninitialized_copy(src, src + run, dst);
+
+        n_nodes += run;
+        src += run;
+        count -= run;
     }
-    n_nodes--;
-    chunks[n_chunks - 1]->n_left++;
-    operator delete[](temp);
 }
 
-template<typename T, size_t n>
-void Deque<T, n>::remove_all(T& key) {
+template<typename T, size_t chunk_bytes>
+void Deque<T, chunk_bytes>::prepend(const T* src, size_t count) {
+    /* Fill from the back of src so the run keeps its order in front of the current elements */
+    while(count > 0) {
+        if(front_offset == 0) push_chunk_front();
 
+        size_t run = std::min(count, front_offset);
+        T* dst = chunk_at(0)->data() + front_offset - run;
+        if constexpr(std::is_trivially_copyable_v<T>)   std::memcpy(dst, src + count - run, sizeof(T) * run);
+        else                                            std::uninitialized_copy(src + count - run, src + count, dst);
+
+        front_offset -= run;
+        n_nodes += run;
+        count -= run;
+    }
 }
 
-template<typename T, size_t n>
-void Deque<T, n>::remove_all(T&& key) {
-    
+template<typename T, size_t chunk_bytes>
+template<typename F>
+void Deque<T, chunk_bytes>::for_each_segment(F&& fn) {
+    size_t index = front_offset;
+    size_t end = front_offset + n_nodes;
+
+    while(index < end) {
+        size_t run = std::min(end - index, n - index % n);
+        T* data = chunk_at(index / n)->data() + index % n;
+
+        if constexpr(std::is_same_v<std::invoke_result_t<F, T*, size_t>, bool>) {
+            if(!fn(data, run)) return;
+        } else {
+            fn(data, run);
+        }
+        index += run;
+    }
 }
 
-template<typename T, size_t n>
-void Deque<T, n>::for_each(std::function<void(T&)> call_back) {
-    for(size_t i = 0; i < len(); i++)
-        call_back((*this)[i]);
+template<typename T, size_t chunk_bytes>
+template<Visitor<T&> F>
+void Deque<T, chunk_bytes>::for_each(F call_back) {
+    for_each_segment([&call_back](T* data, size_t count) {
+        for(size_t i = 0; i < count; i++) call_back(data[i]);
+    });
 }
 
-template<typename T, size_t n>
-Enumerable<T> Deque<T, n>::where(std::function<bool(const T&)> match_func) {
+template<typename T, size_t chunk_bytes>
+template<Predicate<const T&> F>
+Enumerable<T> Deque<T, chunk_bytes>::where(F match_func) {
     Enumerable<T> enumerable;
-    for(auto& x : *this)
-        if(match_func(x)) enumerable.insert(x); //enumerable.insert(x);
+    for_each_segment([&](T* data, size_t count) {
+        for(size_t i = 0; i < count; i++)
+            if(match_func(data[i])) enumerable.insert(data[i]);
+    });
     return enumerable;
 }
 
-template<typename T, size_t n>
-bool Deque<T, n>::contains(T& key) {
-    return find(key) != std::numeric_limits<size_t>::max();
+template<typename T, size_t chunk_bytes>
+bool Deque<T, chunk_bytes>::contains(T& key) {
+    return find_index(key) != std::numeric_limits<size_t>::max();
 }
 
-template<typename T, size_t n>
-bool Deque<T, n>::contains(T&& key) {
-    return find(key) != std::numeric_limits<size_t>::max();
+template<typename T, size_t chunk_bytes>
+bool Deque<T, chunk_bytes>::contains(T&& key) {
+    return find_index(key) != std::numeric_limits<size_t>::max();
 }
 
-template<typename T, size_t n>
-size_t Deque<T, n>::find(T& key) {
-    for(size_t i = 0; i < len(); i++)
-        if((*this)[i] == key) return i;
-    return std::numeric_limits<size_t>::max(); /* key not found so max size_t value is returned as indicator */
+template<typename T, size_t chunk_bytes>
+size_t Deque<T, chunk_bytes>::find(T& key) {
+    return find_index(key);
 }
 
-template<typename T, size_t n>
-size_t Deque<T, n>::find(T&& key) {
-    for(size_t i = 0; i < len(); i++)
-        if((*this)[i] == key) return i;
-    return std::numeric_limits<size_t>::max();
+template<typename T, size_t chunk_bytes>
+size_t Deque<T, chunk_bytes>::find(T&& key) {
+    return find_index(key);
 }
 
-template<typename T, size_t n>
-T& Deque<T, n>::first() {
+template<typename T, size_t chunk_bytes>
+size_t Deque<T, chunk_bytes>::find_index(const T& key) {
+    size_t base = 0;
+    size_t found = std::numeric_limits<size_t>::max(); /* key not found so max size_t value is returned as indicator */
+
+    for_each_segment([&](T* data, size_t count) {
+        for(size_t i = 0; i < count; i++) {
+            if(data[i] == key) {
+                found = base + i;
+                return false;
+            }
+        }
+        base += count;
+        return true;
+    });
+    return found;
+}
+
+template<typename T, size_t chunk_bytes>
+T& Deque<T, chunk_bytes>::first() {
     return (*this)[0];
 }
 
-template<typename T, size_t n>
-T& Deque<T, n>::last() {
+template<typename T, size_t chunk_bytes>
+T& Deque<T, chunk_bytes>::last() {
     return (*this)[n_nodes - 1];
 }
 
@@ -1,21 +1,27 @@
 #pragma once
 #include "LinkedList.hpp"
 #include "Vector.hpp"
+#include "Query.hpp"
+#include "ParallelQuery.hpp"
+#include "Aggregate.hpp"
 
 namespace gdamn::data {
 
-/* Implementation relies on LinkedList<T> for now */
+/*
+ * Materialized results, stored contiguously in a Vector<T> so they can be indexed, counted in O(1) and handed over
+ * to to_vector() without copying when the Enumerable is a temporary.
+ */
 template<typename T>
 class Enumerable {
 public:
     Enumerable() {}
-    ~Enumerable() {}
+    explicit Enumerable(size_t n) : internal(n) {}
 
     class Iterator {
     public:
         Iterator() { }
 
-        Iterator(Iterator& itr) {
+        Iterator(const Iterator& itr) {
             this->internal_itr = itr.internal_itr;
         }
 
@@ -23,7 +29,7 @@ public:
             this->internal_itr = std::move(itr.internal_itr);
         }
 
-        Iterator& operator=(Iterator& other) {
+        Iterator& operator=(const Iterator& other) {
             this->internal_itr = other.internal_itr;
             return *this;
         }
@@ -55,10 +61,12 @@ public:
 
         Iterator& operator+=(size_t n) {
             internal_itr += n;
+            return *this;
         }
 
         Iterator& operator-=(size_t n) {
             internal_itr -= n;
+            return *this;
         }
 
         T& operator*() {
@@ -74,10 +82,10 @@ public:
         }
 
     private:
-        Iterator(typename LinkedList<T>::Iterator itr) {
+        Iterator(typename Vector<T>::Iterator itr) {
             this->internal_itr = itr;
         }
-        typename LinkedList<T>::Iterator internal_itr;
+        typename Vector<T>::Iterator internal_itr;
         friend Enumerable<T>;
     };
 
@@ -87,14 +95,27 @@ public:
         return ll;
     }
 
-    Vector<T> to_vector() {
-        Vector<T> vector;
-        vector.realign(internal.len());
-        for(auto& x : internal) vector.insert(x);
-        return vector;
+    Vector<T> to_vector() & {
+        return internal;
+    }
+
+    /* A temporary gives its storage away, e.g. table.where(...).to_vector() */
+    Vector<T> to_vector() && {
+        return std::move(internal);
+    }
+
+    /* Lazy pipeline over these results, for chains that shouldn't copy at every step */
+    auto query() {
+        return data::query(*this);
+    }
+
+    /* Same pipeline split across the Scheduler's workers, see ParallelQuery */
+    auto as_parallel(size_t grain = 0, ParallelOrder order = ParallelOrder::Ordered) {
+        return data::as_parallel(*this, grain, order);
     }
 
-    Enumerable<T> where(std::function<bool(const T&)> match_func) {
+    template<Predicate<const T&> F>
+    Enumerable<T> where(F match_func) {
         Enumerable<T> enumerable;
         for(auto& x : internal) {
             if(match_func(x)) enumerable.insert(x);
@@ -102,6 +123,70 @@ public:
         return enumerable;
     }
 
+    template<Predicate<const T&> F>
+    size_t count_if(F match_func) {
+        size_t total = 0;
+        for(size_t i = 0; i < internal.len(); i++) total += match_func(internal[i]) ? 1 : 0;
+        return total;
+    }
+
+    /* Numeric element types go through the SIMD kernels in Aggregate.hpp, anything else needs + / < */
+    T sum() {
+        if constexpr(numeric) return aggregate::sum(internal.data(), internal.len());
+        T total = T();
+        for(size_t i = 0; i < internal.len(); i++) total += internal[i];
+        return total;
+    }
+
+    T min(T fallback = T()) {
+        if(internal.len() == 0) return fallback;
+        if constexpr(numeric) return aggregate::min(internal.data(), internal.len());
+        size_t best = 0;
+        for(size_t i = 1; i < internal.len(); i++) if(internal[i] < internal[best]) best = i;
+        return internal[best];
+    }
+
+    T max(T fallback = T()) {
+        if(internal.len() == 0) return fallback;
+        if constexpr(numeric) return aggregate::max(internal.data(), internal.len());
+        size_t best = 0;
+        for(size_t i = 1; i < internal.len(); i++) if(internal[best] < internal[i]) best = i;
+        return internal[best];
+    }
+
+    /* 0 when empty */
+    double average() requires (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) {
+        return aggregate::average(internal.data(), internal.len());
+    }
+
+    /* First occurrence of every value, in order. Needs std::hash<T> and == */
+    Enumerable<T> distinct() {
+        Enumerable<T> unique;
+        aggregate::KeyIndex<T> index(internal.len());
+        for(size_t i = 0; i < internal.len(); i++) {
+            size_t next = unique.len();
+            if(index.find_or_add(internal[i], next, [&unique](size_t at) -> const T& { return unique[at]; }) == next)
+                unique.insert(internal[i]);
+        }
+        return unique;
+    }
+
+    /* Pairs of key and the elements with that key, groups in order of their first element, elements in order */
+    template<Visitor<const T&> F>
+    auto group_by(F key_func) {
+        using K = std::decay_t<std::invoke_result_t<F&, const T&>>;
+        Enumerable<std::pair<K, Enumerable<T>>> groups;
+        aggregate::KeyIndex<K> index(internal.len());
+        for(size_t i = 0; i < internal.len(); i++) {
+            K key = key_func(internal[i]);
+            size_t next = groups.len();
+            size_t at = index.find_or_add(key, next, [&groups](size_t at) -> const K& { return groups[at].first; });
+            if(at == next) groups.insert(std::pair<K, Enumerable<T>>(std::move(key), Enumerable<T>()));
+            groups[at].second.insert(internal[i]);
+        }
+        return groups;
+    }
+
     T& first() {
         return internal.first();
     }
@@ -115,10 +200,14 @@ public:
     }
 
     void insert(T&& x) {
-        internal.insert(x);
+        internal.insert(std::move(x));
     }
 
+    T& operator[](size_t i) { return internal[i]; }
+    const T& operator[](size_t i) const { return internal[i]; }
+
     inline size_t len() const { return internal.len(); }
+    inline bool empty() const { return internal.len() == 0; }
     
     inline Iterator begin() {
         return Iterator(internal.begin());
@@ -129,7 +218,9 @@ public:
     }
 
 private:
-    LinkedList<T> internal;
+    static constexpr bool numeric = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+
+    Vector<T> internal;
 };
 
 }
\ No newline at end of file
@@ -2,9 +2,22 @@
 #include "Enumerable.hpp"
 #include "Array.hpp"
 #include <utility>
+#include <functional>
 
 namespace gdamn::data {
 
+/*
+ * Key types HashTable<T, ...> can look up without constructing a T. std::hash<T> opts in with is_transparent
+ * (as for std::unordered_map), which promises it hashes K and an equal T identically.
+ */
+template<typename K, typename T>
+concept LookupKey = !std::is_same_v<std::remove_cvref_t<K>, T>
+    && requires { typename std::hash<T>::is_transparent; }
+    && requires(const K& key, const T& stored) {
+        { std::hash<T>{}(key) } -> std::convertible_to<size_t>;
+        { stored == key } -> std::convertible_to<bool>;
+    };
+
 template<typename T, typename U, size_t bucket_count>
 class HashTable {
 public:
@@ -21,23 +34,32 @@ public:
 
     bool contains(const T& key);
     bool contains(const T&& key);
+    template<LookupKey<T> K>
+    bool contains(const K& key);
 
     void remove(const T& key);
     void remove(const T&& key);
+    template<LookupKey<T> K>
+    void remove(const K& key);
     void remove_all(const T& key);
     void remove_all(const T&& key);
     void remove_all(const std::pair<T, U>& key_pair);
     void remove_all(const std::pair<T, U>&& key_pair);
-    void remove_if(std::function<bool(const T&, const U&)>);
+    template<Predicate<const T&, const U&> F>
+    void remove_if(F match_func);
 
-    void for_each(std::function<void(T&, U&)> call_back);
+    template<Visitor<T&, U&> F>
+    void for_each(F call_back);
     
     /* Returns the keys that matched the provided function */
-    Enumerable<T> where(std::function<bool(const T&, const U&)> match_func);
+    template<Predicate<const T&, const U&> F>
+    Enumerable<T> where(F match_func);
     /* Returns the values that matched the provided function */
-    Enumerable<U> where_val(std::function<bool(const T&, const U&)> match_func);
+    template<Predicate<const T&, const U&> F>
+    Enumerable<U> where_val(F match_func);
     /* Returns pair of keys & values that matched the provided function  */
-    Enumerable<std::pair<T, U>> where_pair(std::function<bool(const T&, const U&)> match_func);
+    template<Predicate<const T&, const U&> F>
+    Enumerable<std::pair<T, U>> where_pair(F match_func);
 
     U& operator[](const T& key) {
         auto& ll = buckets[hash(key)];
@@ -57,6 +79,17 @@ public:
         return ll.last().second;
     }
 
+    /* Only builds a T from key when it has to be inserted */
+    template<LookupKey<T> K>
+    U& operator[](const K& key) {
+        auto& ll = buckets[hash(key)];
+        for(auto& i : ll)
+            if(auto& [k, v] = i; k == key) return v;
+        ll.insert({ T(key), std::move(U()) });
+        nodes_num++;
+        return ll.last().second;
+    }
+
     size_t len() const { return nodes_num; }
 
 private:
@@ -65,6 +98,11 @@ private:
         return std::hash<T>{}(key) % bucket_count;
     }
 
+    template<LookupKey<T> K>
+    size_t hash(const K& key) const {
+        return std::hash<T>{}(key) % bucket_count;
+    }
+
     size_t nodes_num = 0;
     Array<LinkedList<std::pair<T, U>>, bucket_count> buckets;  
 };
@@ -107,6 +145,14 @@ bool HashTable<T, U, bucket_count>::contains(const T&& key) {
     return false;
 }
 
+template<typename T, typename U, size_t bucket_count>
+template<LookupKey<T> K>
+bool HashTable<T, U, bucket_count>::contains(const K& key) {
+    for(const auto& i : buckets[hash(key)])
+        if(const auto& [k, v] = i; k == key) return true;
+    return false;
+}
+
 template<typename T, typename U, size_t bucket_count>
 void HashTable<T, U, bucket_count>::remove(const T& key) {
     auto& ll = buckets[hash(key)];
@@ -139,6 +185,19 @@ void HashTable<T, U, bucket_count>::remove(const T&& key) {
     }
 }
 
+template<typename T, typename U, size_t bucket_count>
+template<LookupKey<T> K>
+void HashTable<T, U, bucket_count>::remove(const K& key) {
+    auto& ll = buckets[hash(key)];
+    for(auto i = ll.begin(); i != ll.end(); i++) {
+        if(const auto& [k, v] = *i; k == key) {
+            nodes_num--;
+            ll.remove(i);
+            return;
+        }
+    }
+}
+
 template<typename T, typename U, size_t bucket_count>
 void HashTable<T, U, bucket_count>::remove_all(const T& key) {
     LinkedList<std::pair<T, U>>& ll = buckets[hash(key)];
@@ -215,7 +274,8 @@ void HashTable<T, U, bucket_count>::remove_all(const std::pair<T, U>&& key) {
 }
 
 template<typename T, typename U, size_t bucket_count>
-void HashTable<T, U, bucket_count>::for_each(std::function<void(T&, U&)> call_back) {
+template<Visitor<T&, U&> F>
+void HashTable<T, U, bucket_count>::for_each(F call_back) {
     for(auto& bucket_list : buckets) {
         for(auto& pair : bucket_list) {
             auto& [k, v] = pair;
@@ -225,7 +285,8 @@ void HashTable<T, U, bucket_count>::for_each(std::function<void(T&, U&)> call_ba
 }
 
 template<typename T, typename U, size_t bucket_count>
-Enumerable<T> HashTable<T, U, bucket_count>::where(std::function<bool(const T&, const U&)> match_func) {
+template<Predicate<const T&, const U&> F>
+Enumerable<T> HashTable<T, U, bucket_count>::where(F match_func) {
     Enumerable<T> enumerable;
     for(auto& bucket_list : buckets) {
         for(auto& [k, v] : bucket_list) {
@@ -236,7 +297,8 @@ Enumerable<T> HashTable<T, U, bucket_count>::where(std::function<bool(const T&,
 }
 
 template<typename T, typename U, size_t bucket_count>
-Enumerable<U> HashTable<T, U, bucket_count>::where_val(std::function<bool(const T&, const U&)> match_func) {
+template<Predicate<const T&, const U&> F>
+Enumerable<U> HashTable<T, U, bucket_count>::where_val(F match_func) {
     Enumerable<U> enumerable;
     for(auto& bucket_list : buckets) {
         for(auto& [k, v] : bucket_list) {
@@ -247,7 +309,8 @@ Enumerable<U> HashTable<T, U, bucket_count>::where_val(std::function<bool(const
 }
 
 template<typename T, typename U, size_t bucket_count>
-Enumerable<std::pair<T, U>> HashTable<T, U, bucket_count>::where_pair(std::function<bool(const T&, const U&)> match_func) {
+template<Predicate<const T&, const U&> F>
+Enumerable<std::pair<T, U>> HashTable<T, U, bucket_count>::where_pair(F match_func) {
     Enumerable<std::pair<T, U>> enumerable;
     for(auto& bucket_list : buckets) {
         for(auto& pair : bucket_list) {
@@ -259,7 +322,8 @@ Enumerable<std::pair<T, U>> HashTable<T, U, bucket_count>::where_pair(std::funct
 }
 
 template<typename T, typename U, size_t bucket_count>
-void HashTable<T, U, bucket_count>::remove_if(std::function<bool(const T&, const U&)> call_back) {    
+template<Predicate<const T&, const U&> F>
+void HashTable<T, U, bucket_count>::remove_if(F call_back) {    
     for(auto& bucket_list : buckets) {
         auto i = bucket_list.begin();
         for(auto j = bucket_list.begin(); i != bucket_list.end();) {
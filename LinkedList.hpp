@@ -2,7 +2,8 @@
 #include <memory>
 #include <limits>
 #include <cstdio>
-#include <functional>
+#include <utility>
+#include "Concepts.hpp"
 namespace gdamn::data {
 
 template<typename T>
@@ -10,6 +11,11 @@ class LinkedList {
 private:
     template<typename U>
     struct DoubleNode {
+        DoubleNode() : data() {}
+
+        template<typename... Args>
+        DoubleNode(std::in_place_t, Args&&... args) : data(std::forward<Args>(args)...) {}
+
         DoubleNode<U>* next = nullptr;
         DoubleNode<U>* prev = nullptr;
         U data;
@@ -44,7 +50,7 @@ public:
     public:
         Iterator() {}
 
-        Iterator(Iterator& itr) {
+        Iterator(const Iterator& itr) {
             this->curr_node = itr.curr_node;
         }
 
@@ -53,7 +59,7 @@ public:
             itr.curr_node = nullptr;
         }
 
-        Iterator& operator=(Iterator& other) {
+        Iterator& operator=(const Iterator& other) {
             this->curr_node = other.curr_node;
             return *this;
         }
@@ -118,7 +124,8 @@ public:
         DoubleNode<T>* curr_node = nullptr;
     };
 
-    void for_each(std::function<void(T&)> call_back);
+    template<Visitor<T&> F>
+    void for_each(F call_back);
 
     void insert(T& key);
     void insert(T&& key);
@@ -126,6 +133,14 @@ public:
     void insert_front(T&& key);
     void insert_back(T& key);
     void insert_back(T&& key);
+
+    /* Constructs the value directly inside the new node */
+    template<typename... Args>
+    T& emplace_front(Args&&... args);
+    template<typename... Args>
+    T& emplace_back(Args&&... args);
+    template<typename... Args>
+    Iterator emplace(Iterator where, Args&&... args); /* Inserts in front of where */
     
     void remove(T& key);
     void remove(T&& key);
@@ -162,70 +177,82 @@ LinkedList<T>::LinkedList() {
 
 template<typename T>
 LinkedList<T>::~LinkedList() {
-    DoubleNode<T>* itr = head->next;
+    DoubleNode<T>* itr = head; /* Null once moved from */
 
-    while(itr->next != nullptr) {
+    while(itr != nullptr) {
+        DoubleNode<T>* del_node = itr;
         itr = itr->next;
-        delete itr->prev;
+        delete del_node;
     }
-    
-    delete head;
 }
 
 template<typename T>
-LinkedList<T>::LinkedList(std::initializer_list<T> list) {
-    for(auto& i : list) insert(i);
+LinkedList<T>::LinkedList(std::initializer_list<T> list) : LinkedList() {
+    for(auto& i : list) emplace_back(i);
 }
 
 template<typename T>
-void LinkedList<T>::for_each(std::function<void(T&)> call_back) {
+template<Visitor<T&> F>
+void LinkedList<T>::for_each(F call_back) {
     for(auto& val : *this) call_back(val);
 }
 
 template<typename T>
 void LinkedList<T>::insert(T& key) {
-    back->data = key;
-    back->next = new DoubleNode<T>();
-    back->next->prev = back;
-    back = back->next;
-    length++;
+    emplace_back(key);
 }
 
 template<typename T>
 void LinkedList<T>::insert(T&& key) {
-    back->data = std::move(key);
-    back->next = new DoubleNode<T>();
-    back->next->prev = back;
-    back = back->next;
-    length++;
+    emplace_back(std::move(key));
 }
 
 template<typename T>
 void LinkedList<T>::insert_front(T& key) {
-    DoubleNode<T>* new_head = new DoubleNode<T>();
-    new_head->data = key;
-    new_head->next = head->next;
-    head->next = new_head;
-    length++;
+    emplace_front(key);
 }
 
 template<typename T>
 void LinkedList<T>::insert_front(T&& key) {
-    DoubleNode<T>* new_head = new DoubleNode<T>();
-    new_head->data = std::move(key);
-    new_head->next = head->next;
-    head->next = new_head;
-    length++;
+    emplace_front(std::move(key));
 }
 
 template<typename T>
 void LinkedList<T>::insert_back(T& key) {
-    insert(key);
+    emplace_back(key);
 }
 
 template<typename T>
 void LinkedList<T>::insert_back(T&& key) {
-    insert(key);
+    emplace_back(std::move(key));
+}
+
+template<typename T>
+template<typename... Args>
+T& LinkedList<T>::emplace_front(Args&&... args) {
+    return *emplace(begin(), std::forward<Args>(args)...);
+}
+
+template<typename T>
+template<typename... Args>
+T& LinkedList<T>::emplace_back(Args&&... args) {
+    return *emplace(end(), std::forward<Args>(args)...);
+}
+
+template<typename T>
+template<typename... Args>
+typename LinkedList<T>::Iterator LinkedList<T>::emplace(Iterator where, Args&&... args) {
+    DoubleNode<T>* node = new DoubleNode<T>(std::in_place, std::forward<Args>(args)...);
+    DoubleNode<T>* next = where.curr_node;
+
+    /* The first node keeps a null prev, head only links forward */
+    node->next = next;
+    node->prev = next->prev;
+    if(next->prev != nullptr)   next->prev->next = node;
+    else                        head->next = node;
+    next->prev = node;
+    length++;
+    return Iterator(node);
 }
 
 template<typename T>
@@ -303,7 +330,8 @@ void LinkedList<T>::pop_front() {
 template<typename T>
 void LinkedList<T>::pop_back() {
     auto del_node = back->prev;
-    del_node->prev->next = back;
+    if(del_node->prev != nullptr)   del_node->prev->next = back;
+    else                            head->next = back;
     back->prev = del_node->prev;
     delete del_node;
     length--;
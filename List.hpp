@@ -1,6 +1,6 @@
 #pragma once
 #include <limits>
-#include <functional>
+#include <utility>
 #include "Enumerable.hpp"
 
 namespace gdamn::data {
@@ -10,7 +10,10 @@ class List {
 private:
     template<typename U>
     struct Node {
-        U data                   = {};
+        template<typename... Args>
+        Node(Args&&... args) : data(std::forward<Args>(args)...) {}
+
+        U data;
         List<T>::Node<U>* next   = nullptr;
     };
 
@@ -26,7 +29,7 @@ public:
     public:
         Iterator() {}
         
-        Iterator(Iterator& itr) {
+        Iterator(const Iterator& itr) {
             this->curr_node = itr.curr_node;
         }
 
@@ -35,7 +38,7 @@ public:
             itr.curr_node = nullptr;
         }
 
-        Iterator& operator=(List<T>::Iterator& other) {
+        Iterator& operator=(const List<T>::Iterator& other) {
             this->curr_node = other.curr_node;
             return *this;
         }
@@ -79,16 +82,28 @@ public:
             this->curr_node = itr;
         }
 
-        Node<T>* curr_node;
+        Node<T>* curr_node = nullptr;
         friend List<T>;
     };
 
-    void for_each(std::function<void(T&)> call_back);
-    Enumerable<T> where(std::function<bool(const T&)> match_func);
+    template<Visitor<T&> F>
+    void for_each(F call_back);
+    template<Predicate<const T&> F>
+    Enumerable<T> where(F match_func);
 
     void insert(T& key);
     void insert(T&& key);
 
+    /* Constructs the value directly inside the new node */
+    template<typename... Args>
+    T& emplace_front(Args&&... args);
+    template<typename... Args>
+    T& emplace_back(Args&&... args);
+    template<typename... Args>
+    Iterator emplace_after(Iterator where, Args&&... args);
+    template<typename... Args>
+    Iterator emplace(Iterator where, Args&&... args); /* Inserts in front of where, O(n) unless where is begin() or end() */
+
     void remove(T& key);
     void remove(T&& key);
     void pop_front();
@@ -98,61 +113,64 @@ public:
     bool contains(T& key);
     bool contains(T&& key);
 
-    T& front()          { return head->data; }
-    Iterator begin()    { return Iterator(head); }
+    T& front()          { return first_node->data; }
+    Iterator begin()    { return Iterator(first_node); }
     Iterator end()      { return Iterator(nullptr); };
     size_t len()        { return node_count; };
 
 private:
     size_t node_count           = 0;
-    List<T>::Node<T>* head      = nullptr;
+    List<T>::Node<T>* first_node = nullptr;
+    List<T>::Node<T>* head      = nullptr; /* Last node, insert appends behind it */
     friend List<T>::Iterator;
 };
 
 template<typename T>
 List<T>::List(T head_value) {
-    this->head = new Node<T>();
-    head->data = head_value;
-    node_count++;
+    emplace_back(std::move(head_value));
 }
 
 template<typename T>
 List<T>::List(std::initializer_list<T> l) {
-    this->head = new Node<T>();
-
     for(const auto& key : l) {
-        insert(key);
+        emplace_back(key);
     }
 }
 
 template<typename T>
 List<T>::~List() {
-    auto itr = this->head;
+    auto itr = this->first_node;
     Node<T>* des_node = nullptr;
 
     while(itr != nullptr) {
         des_node = itr;
         itr = itr->next;
-        delete[] des_node;
+        delete des_node;
     }
 }
 
 template<typename T>
 List<T>& List<T>::operator=(List<T>&& other) {
+    this->~List();
+    this->first_node = other.first_node;
     this->head = other.head;
     this->node_count = other.node_count;
 
+    other.first_node = nullptr;
     other.head = nullptr;
+    other.node_count = 0;
     return *this;
 }
 
 template<typename T>
-void List<T>::for_each(std::function<void(T&)> call_back) {
+template<Visitor<T&> F>
+void List<T>::for_each(F call_back) {
     for(auto& val : *this) call_back(val);
 }
 
 template<typename T>
-Enumerable<T> List<T>::where(std::function<bool(const T&)> match_func) {
+template<Predicate<const T&> F>
+Enumerable<T> List<T>::where(F match_func) {
     Enumerable<T> enumerable;
     for(auto& x : *this)
         if(match_func(x)) enumerable.insert(x);
@@ -161,18 +179,66 @@ Enumerable<T> List<T>::where(std::function<bool(const T&)> match_func) {
 
 template<typename T>
 void List<T>::insert(T& key) {
-    head->data = key;
-    head->next = new Node<T>();
-    head = head->next;
-    node_count++;
+    emplace_back(key);
 }
 
 template<typename T>
 void List<T>::insert(T&& key) {
-    head->next = new Node<T>();
-    head = head->next;
-    head->data = std::move(key);
+    emplace_back(std::move(key));
+}
+
+template<typename T>
+template<typename... Args>
+T& List<T>::emplace_front(Args&&... args) {
+    Node<T>* node = new Node<T>(std::forward<Args>(args)...);
+    node->next = first_node;
+    first_node = node;
+    if(head == nullptr) head = node;
+    node_count++;
+    return node->data;
+}
+
+template<typename T>
+template<typename... Args>
+T& List<T>::emplace_back(Args&&... args) {
+    Node<T>* node = new Node<T>(std::forward<Args>(args)...);
+    if(head != nullptr) head->next = node;
+    else                first_node = node;
+    head = node;
+    node_count++;
+    return node->data;
+}
+
+template<typename T>
+template<typename... Args>
+typename List<T>::Iterator List<T>::emplace_after(Iterator where, Args&&... args) {
+    if(where.curr_node == head) {
+        emplace_back(std::forward<Args>(args)...);
+        return Iterator(head);
+    }
+
+    Node<T>* node = new Node<T>(std::forward<Args>(args)...);
+    node->next = where.curr_node->next;
+    where.curr_node->next = node;
     node_count++;
+    return Iterator(node);
+}
+
+template<typename T>
+template<typename... Args>
+typename List<T>::Iterator List<T>::emplace(Iterator where, Args&&... args) {
+    if(where.curr_node == first_node) {
+        emplace_front(std::forward<Args>(args)...);
+        return begin();
+    }
+    if(where.curr_node == nullptr) {
+        emplace_back(std::forward<Args>(args)...);
+        return Iterator(head);
+    }
+
+    Node<T>* prev = first_node;
+    while(prev->next != where.curr_node) prev = prev->next;
+    return emplace_after(Iterator(prev), std::forward<Args>(args)...);
 }
 
 template<typename T>
@@ -209,38 +275,35 @@ bool List<T>::contains(T&& key) {
 
 template<typename T>
 void List<T>::remove(T& key) {
-    Node<T>* itr = head;
-    Node<T>* prev;
+    Node<T>* itr = first_node;
+    Node<T>* prev = nullptr;
     while(itr != nullptr) {
         if(itr->data == key) break;
         prev = itr;
         itr = itr->next;
     }
-    if(itr == head) head = head->next;
-    prev->next = itr->next;
-    delete[] itr;
+    if(itr == nullptr) return;
+
+    if(prev != nullptr) prev->next = itr->next;
+    else                first_node = itr->next;
+    if(itr == head) head = prev;
+    delete itr;
+    node_count--;
 }
 
 template<typename T>
 void List<T>::remove(T&& key) {
-    Node<T>* itr = head;
-    Node<T>* prev;
-    while(itr != nullptr) {
-        if(itr->data == key) break;
-        prev = itr;
-        itr = itr->next;
-    }
-    if(itr == head) head = head->next;
-    prev->next = itr->next;
-    delete[] itr;
+    remove(key);
 }
 
 template<typename T>
 void List<T>::pop_front() {
-    if(head->next == nullptr) head->next = new Node<T>();
-    auto del = head;
-    head = head->next;
-    delete[] del;
+    if(first_node == nullptr) return;
+    auto del = first_node;
+    first_node = first_node->next;
+    if(del == head) head = nullptr;
+    delete del;
+    node_count--;
 }
 
 }
\ No newline at end of file
@@ -0,0 +1,200 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace gdamn::data {
+
+/*
+ * Bounded multi-producer / multi-consumer queue (Vyukov style).
+ * Every cell carries a sequence number telling whether it is ready for the producer or the consumer
+ * of a given lap, so claiming a run of positions is one CAS and there is no shared lock.
+ * try_* calls never block, push/pop spin briefly and then sleep on the opposite position.
+ */
+template<typename T>
+class MpmcQueue {
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* value() { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+public:
+    explicit MpmcQueue(size_t capacity); /* Rounded up to a power of two */
+    ~MpmcQueue();
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    bool try_push(const T& val)     { return try_emplace(val); }
+    bool try_push(T&& val)          { return try_emplace(std::move(val)); }
+    template<typename... Args>
+    bool try_emplace(Args&&... args);
+    size_t try_push_n(const T* src, size_t count);
+    void push(const T& val);
+    void push(T&& val);
+
+    bool try_pop(T& out);
+    size_t try_pop_n(T* dst, size_t count);
+    void pop(T& out);
+
+    size_t capacity() const { return mask + 1; }
+
+private:
+    size_t claim(std::atomic<size_t>& position, size_t lap_offset, size_t count, size_t& first);
+    void wait_for_space();
+    void wait_for_data();
+
+    Cell*   cells = nullptr;
+    size_t  mask = 0;
+    alignas(64) std::atomic<size_t> enqueue_pos = 0;
+    alignas(64) std::atomic<size_t> dequeue_pos = 0;
+    alignas(64) char padding = 0; /* Keeps dequeue_pos clear of whatever follows the queue */
+};
+
+template<typename T>
+MpmcQueue<T>::MpmcQueue(size_t capacity) {
+    size_t size = 2;
+    while(size < capacity) size *= 2;
+
+    cells = new Cell[size];
+    mask = size - 1;
+    for(size_t i = 0; i < size; i++)
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+template<typename T>
+MpmcQueue<T>::~MpmcQueue() {
+    size_t end = enqueue_pos.load(std::memory_order_relaxed);
+    for(size_t i = dequeue_pos.load(std::memory_order_relaxed); i != end; i++)
+        cells[i & mask].value()->~T();
+    delete[] cells;
+}
+
+/*
+ * Claims up to count consecutive positions starting at first. The cell for position p is ready when its
+ * sequence equals p + lap_offset (0 for producers, 1 for consumers). Returns how many were claimed, 0 when full/empty.
+ */
+template<typename T>
+size_t MpmcQueue<T>::claim(std::atomic<size_t>& position, size_t lap_offset, size_t count, size_t& first) {
+    size_t pos = position.load(std::memory_order_relaxed);
+
+    for(;;) {
+        size_t ready = 0;
+        intptr_t diff = 0;
+        while(ready < count) {
+            size_t seq = cells[(pos + ready) & mask].sequence.load(std::memory_order_acquire);
+            diff = (intptr_t)(seq - (pos + ready + lap_offset));
+            if(diff != 0) break;
+            ready++;
+        }
+
+        if(ready == 0) {
+            if(diff < 0) return 0; /* The cell still belongs to the previous lap */
+            pos = position.load(std::memory_order_relaxed); /* Someone else claimed it, retry */
+            continue;
+        }
+
+        if(position.compare_exchange_weak(pos, pos + ready, std::memory_order_relaxed)) {
+            first = pos;
+            return ready;
+        }
+    }
+}
+
+template<typename T>
+template<typename... Args>
+bool MpmcQueue<T>::try_emplace(Args&&... args) {
+    size_t pos;
+    if(claim(enqueue_pos, 0, 1, pos) == 0) return false;
+
+    Cell& cell = cells[pos & mask];
+    new (cell.storage) T(std::forward<Args>(args)...);
+    cell.sequence.store(pos + 1, std::memory_order_release);
+    enqueue_pos.notify_all();
+    return true;
+}
+
+template<typename T>
+size_t MpmcQueue<T>::try_push_n(const T* src, size_t count) {
+    size_t pos;
+    size_t claimed = claim(enqueue_pos, 0, count, pos);
+
+    for(size_t i = 0; i < claimed; i++) {
+        Cell& cell = cells[(pos + i) & mask];
+        new (cell.storage) T(src[i]);
+        cell.sequence.store(pos + i + 1, std::memory_order_release);
+    }
+    if(claimed > 0) enqueue_pos.notify_all();
+    return claimed;
+}
+
+template<typename T>
+bool MpmcQueue<T>::try_pop(T& out) {
+    size_t pos;
+    if(claim(dequeue_pos, 1, 1, pos) == 0) return false;
+
+    Cell& cell = cells[pos & mask];
+    out = std::move(*cell.value());
+    cell.value()->~T();
+    cell.sequence.store(pos + mask + 1, std::memory_order_release); /* Ready for the next lap's producer */
+    dequeue_pos.notify_all();
+    return true;
+}
+
+template<typename T>
+size_t MpmcQueue<T>::try_pop_n(T* dst, size_t count) {
+    size_t pos;
+    size_t claimed = claim(dequeue_pos, 1, count, pos);
+
+    for(size_t i = 0; i < claimed; i++) {
+        Cell& cell = cells[(pos + i) & mask];
+        dst[i] = std::move(*cell.value());
+        cell.value()->~T();
+        cell.sequence.store(pos + i + mask + 1, std::memory_order_release);
+    }
+    if(claimed > 0) dequeue_pos.notify_all();
+    return claimed;
+}
+
+/*
+ * Spin for a short while first, then sleep until the opposite position moves.
+ * A claimed but not yet published cell wakes us early; the loop simply retries.
+ */
+template<typename T>
+void MpmcQueue<T>::wait_for_space() {
+    size_t seen = dequeue_pos.load(std::memory_order_acquire);
+    size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+    if(pos - seen < capacity()) return;
+    dequeue_pos.wait(seen, std::memory_order_acquire);
+}
+
+template<typename T>
+void MpmcQueue<T>::wait_for_data() {
+    size_t seen = enqueue_pos.load(std::memory_order_acquire);
+    if(seen != dequeue_pos.load(std::memory_order_relaxed)) return;
+    enqueue_pos.wait(seen, std::memory_order_acquire);
+}
+
+template<typename T>
+void MpmcQueue<T>::push(const T& val) {
+    for(size_t spins = 0; !try_emplace(val); spins++)
+        if(spins >= 128) wait_for_space();
+}
+
+template<typename T>
+void MpmcQueue<T>::push(T&& val) {
+    for(size_t spins = 0; !try_emplace(std::move(val)); spins++) /* val is only moved from once a cell is claimed */
+        if(spins >= 128) wait_for_space();
+}
+
+template<typename T>
+void MpmcQueue<T>::pop(T& out) {
+    for(size_t spins = 0; !try_pop(out); spins++)
+        if(spins >= 128) wait_for_data();
+}
+
+}
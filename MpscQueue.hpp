@@ -0,0 +1,167 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace gdamn::data {
+
+/*
+ * Unbounded multi-producer / single-consumer queue (Vyukov style).
+ * Producers only perform one atomic exchange to link their node, so push is wait-free.
+ * Like List<T>, nodes are singly linked and appended at the tail; the consumer owns a stub node
+ * and every value lives in the node following it.
+ * Consumed nodes go back onto a free stack owned by the queue, so steady traffic doesn't allocate. One producer
+ * at a time pops from it; a producer that finds another one popping allocates instead, which keeps push wait-free.
+ */
+template<typename T>
+class MpscQueue {
+private:
+    struct Node {
+        std::atomic<Node*> next = nullptr;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* value() { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+public:
+    MpscQueue();
+    ~MpscQueue();
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    /* Producer side, callable from any thread */
+    void push(const T& val);
+    void push(T&& val);
+    template<typename... Args>
+    void emplace(Args&&... args);
+
+    /* Consumer side, single thread only */
+    bool try_pop(T& out);
+    template<typename F>
+    size_t drain(F&& call_back);
+    bool empty() const;
+
+private:
+    Node* acquire_node();
+    void recycle_nodes(Node* first, Node* last);
+    void link(Node* node);
+
+    alignas(64) std::atomic<Node*> head;        /* Producers append here */
+    alignas(64) Node* tail;                     /* Consumer-owned stub */
+    alignas(64) std::atomic<Node*> free_nodes = nullptr;
+    std::atomic<bool> popping_free = false;     /* Held by the producer popping free_nodes */
+};
+
+template<typename T>
+MpscQueue<T>::MpscQueue() {
+    tail = new Node();
+    head.store(tail, std::memory_order_relaxed);
+}
+
+template<typename T>
+MpscQueue<T>::~MpscQueue() {
+    drain([](T&) {});
+    delete tail;
+
+    Node* itr = free_nodes.load(std::memory_order_acquire);
+    while(itr != nullptr) {
+        Node* del = itr;
+        itr = itr->next.load(std::memory_order_relaxed);
+        delete del;
+    }
+}
+
+template<typename T>
+typename MpscQueue<T>::Node* MpscQueue<T>::acquire_node() {
+    if(popping_free.exchange(true, std::memory_order_acquire)) return new Node();
+
+    /* With a single popper a node can't leave and come back between load and CAS, so there is no ABA */
+    Node* node = free_nodes.load(std::memory_order_acquire);
+    while(node != nullptr && !free_nodes.compare_exchange_weak(node, node->next.load(std::memory_order_relaxed),
+                                                               std::memory_order_acquire, std::memory_order_acquire));
+    popping_free.store(false, std::memory_order_release);
+
+    if(node == nullptr) return new Node();
+    node->next.store(nullptr, std::memory_order_relaxed);
+    return node;
+}
+
+template<typename T>
+void MpscQueue<T>::recycle_nodes(Node* first, Node* last) {
+    /* Pushing a chain is safe next to the one popper, the CAS just retries when the top moved */
+    Node* top = free_nodes.load(std::memory_order_relaxed);
+    do {
+        last->next.store(top, std::memory_order_relaxed);
+    } while(!free_nodes.compare_exchange_weak(top, first, std::memory_order_release, std::memory_order_relaxed));
+}
+
+template<typename T>
+void MpscQueue<T>::link(Node* node) {
+    Node* prev = head.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+}
+
+template<typename T>
+void MpscQueue<T>::push(const T& val) {
+    Node* node = acquire_node();
+    new (node->storage) T(val);
+    link(node);
+}
+
+template<typename T>
+void MpscQueue<T>::push(T&& val) {
+    Node* node = acquire_node();
+    new (node->storage) T(std::move(val));
+    link(node);
+}
+
+template<typename T>
+template<typename... Args>
+void MpscQueue<T>::emplace(Args&&... args) {
+    Node* node = acquire_node();
+    new (node->storage) T(std::forward<Args>(args)...);
+    link(node);
+}
+
+template<typename T>
+bool MpscQueue<T>::try_pop(T& out) {
+    Node* next = tail->next.load(std::memory_order_acquire);
+    if(next == nullptr) return false; /* Empty, or a producer is between exchange and link */
+
+    out = std::move(*next->value());
+    next->value()->~T();
+    recycle_nodes(tail, tail);
+    tail = next; /* next becomes the new stub */
+    return true;
+}
+
+template<typename T>
+template<typename F>
+size_t MpscQueue<T>::drain(F&& call_back) {
+    size_t count = 0;
+    Node* first = tail;
+    Node* next = tail->next.load(std::memory_order_acquire);
+    if(next == nullptr) return 0;
+
+    /* Consumed stubs still form a chain through next, so they are returned with a single CAS */
+    Node* last = nullptr;
+    while(next != nullptr) {
+        call_back(*next->value());
+        next->value()->~T();
+        last = tail;
+        tail = next;
+        next = tail->next.load(std::memory_order_acquire);
+        count++;
+    }
+    recycle_nodes(first, last);
+    return count;
+}
+
+template<typename T>
+bool MpscQueue<T>::empty() const {
+    return tail->next.load(std::memory_order_acquire) == nullptr;
+}
+
+}
@@ -0,0 +1,203 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include "StringView.hpp"
+#include "StringBuilder.hpp"
+#include "Vector.hpp"
+
+namespace gdamn::data {
+
+/*
+ * Aho-Corasick matcher: add() the patterns, compile() once, then every scan reports all occurrences of all
+ * patterns in a single pass over the text.
+ * The automaton is a full DFA over byte classes (only the bytes that occur in some pattern get a column), stored
+ * as one dense uint32_t table, so each text byte costs one class lookup and one table load. While the automaton
+ * sits in the root state and the patterns start with at most 8 distinct bytes, the scan skips ahead with the
+ * vectorized find_first_of instead of walking the table.
+ */
+class MultiMatcher {
+public:
+    MultiMatcher() {}
+    ~MultiMatcher();
+
+    MultiMatcher(const MultiMatcher&) = delete;
+    MultiMatcher& operator=(const MultiMatcher&) = delete;
+
+    /* Returns the id matches report for this pattern; empty patterns never match. Invalidates compile() */
+    size_t add(StringView pattern);
+    void compile();
+
+    /*
+     * Calls fn(pattern_id, position) for every match, position being where the match starts in text.
+     * Matches come in order of their end position. Returning false from fn stops the scan.
+     */
+    template<typename F>
+    void for_each_match(StringView text, F&& fn) const;
+
+    bool contains_any(StringView text) const;
+    size_t count(StringView text) const;
+
+    size_t len() const                  { return n_patterns; }
+    size_t pattern_len(size_t id) const { return pattern_lens[id]; }
+    bool compiled() const               { return table != nullptr; }
+
+private:
+    void release();
+
+    /* Patterns as added, concatenated, ends[i] is one past the last byte of pattern i */
+    StringBuilder   pattern_bytes;
+    Vector<size_t>  pattern_ends;
+    Vector<size_t>  pattern_lens;
+    size_t          n_patterns = 0;
+
+    /* Compiled automaton, state 0 is the root */
+    uint16_t        byte_class[256] = {};   /* Class 0 is every byte that no pattern contains */
+    size_t          n_classes = 0;
+    uint32_t*       table = nullptr;        /* table[state * n_classes + class] = next state */
+    uint32_t*       outputs = nullptr;      /* First pattern id + 1 ending in state, 0 for none */
+    uint32_t*       output_links = nullptr; /* Nearest proper suffix state with outputs, 0 for none */
+    uint32_t*       same_state = nullptr;   /* Next pattern id + 1 ending in the same state (duplicates) */
+    char            first_bytes[8] = {};    /* Prefilter set, used when n_first_bytes <= 8 */
+    size_t          n_first_bytes = 0;
+};
+
+inline MultiMatcher::~MultiMatcher() {
+    release();
+}
+
+inline void MultiMatcher::release() {
+    delete[] table;
+    delete[] outputs;
+    delete[] output_links;
+    delete[] same_state;
+    table = nullptr;
+    outputs = nullptr;
+    output_links = nullptr;
+    same_state = nullptr;
+}
+
+inline size_t MultiMatcher::add(StringView pattern) {
+    release();
+    pattern_bytes.append(pattern);
+    pattern_ends.emplace_back(pattern_bytes.len());
+    pattern_lens.emplace_back(pattern.len());
+    return n_patterns++;
+}
+
+inline void MultiMatcher::compile() {
+    release();
+    const char* bytes = pattern_bytes.view().data();
+
+    /* Alphabet compression: one column per distinct pattern byte plus the shared "no pattern has it" column */
+    std::memset(byte_class, 0, sizeof(byte_class));
+    n_classes = 1;
+    for(size_t i = 0; i < pattern_bytes.len(); i++) {
+        uint8_t byte = (uint8_t)bytes[i];
+        if(byte_class[byte] == 0) byte_class[byte] = (uint16_t)n_classes++;
+    }
+
+    /* A trie never has more states than pattern bytes + the root */
+    size_t max_states = pattern_bytes.len() + 1;
+    table = new uint32_t[max_states * n_classes]();
+    outputs = new uint32_t[max_states]();
+    output_links = new uint32_t[max_states]();
+    same_state = new uint32_t[n_patterns]();
+    uint32_t* fail = new uint32_t[max_states]();
+    uint32_t* queue = new uint32_t[max_states];
+
+    /* Trie, 0 in the table means "no child" while building since nothing points back at the root */
+    size_t n_states = 1;
+    n_first_bytes = 0;
+    bool too_many_first_bytes = false;
+    for(size_t id = 0, begin = 0; id < n_patterns; begin = pattern_ends[id], id++) {
+        size_t end = pattern_ends[id];
+        if(end == begin) continue;
+
+        uint32_t state = 0;
+        for(size_t i = begin; i < end; i++) {
+            uint32_t& next = table[state * n_classes + byte_class[(uint8_t)bytes[i]]];
+            if(next == 0) next = (uint32_t)n_states++;
+            state = next;
+        }
+        same_state[id] = outputs[state];
+        outputs[state] = (uint32_t)id + 1;
+
+        if(std::memchr(first_bytes, bytes[begin], n_first_bytes) == nullptr) {
+            if(n_first_bytes < sizeof(first_bytes)) first_bytes[n_first_bytes++] = bytes[begin];
+            else too_many_first_bytes = true;
+        }
+    }
+    if(too_many_first_bytes) n_first_bytes = 0;
+
+    /* Breadth first: fill in failure links and turn every missing edge into the failure state's edge */
+    size_t head = 0, tail = 0;
+    for(size_t c = 0; c < n_classes; c++)
+        if(uint32_t child = table[c]; child != 0) queue[tail++] = child; /* Root children fail to the root */
+
+    while(head < tail) {
+        uint32_t state = queue[head++];
+        uint32_t* row = table + (size_t)state * n_classes;
+        const uint32_t* fail_row = table + (size_t)fail[state] * n_classes;
+
+        for(size_t c = 0; c < n_classes; c++) {
+            uint32_t child = row[c];
+            if(child == 0) {
+                row[c] = fail_row[c];
+                continue;
+            }
+            uint32_t child_fail = fail_row[c];
+            fail[child] = child_fail;
+            output_links[child] = outputs[child_fail] != 0 ? child_fail : output_links[child_fail];
+            queue[tail++] = child;
+        }
+    }
+
+    delete[] fail;
+    delete[] queue;
+}
+
+template<typename F>
+void MultiMatcher::for_each_match(StringView text, F&& fn) const {
+    if(table == nullptr) return;
+
+    const char* data = text.data();
+    const size_t size = text.len();
+    uint32_t state = 0;
+
+    for(size_t i = 0; i < size; i++) {
+        if(state == 0 && n_first_bytes != 0) { /* Nothing partially matched, jump to the next possible start */
+            size_t skip = search::find_first_of(data + i, size - i, first_bytes, n_first_bytes);
+            if(skip == search::npos) return;
+            i += skip;
+        }
+
+        state = table[(size_t)state * n_classes + byte_class[(uint8_t)data[i]]];
+        uint32_t hit = outputs[state] != 0 ? state : output_links[state];
+        for(; hit != 0; hit = output_links[hit]) {
+            for(uint32_t id = outputs[hit]; id != 0; id = same_state[id - 1]) {
+                size_t position = i + 1 - pattern_lens[id - 1];
+                if constexpr(std::is_same_v<std::invoke_result_t<F&, size_t, size_t>, bool>) {
+                    if(!fn((size_t)(id - 1), position)) return;
+                } else {
+                    fn((size_t)(id - 1), position);
+                }
+            }
+        }
+    }
+}
+
+inline bool MultiMatcher::contains_any(StringView text) const {
+    bool found = false;
+    for_each_match(text, [&found](size_t, size_t) { found = true; return false; });
+    return found;
+}
+
+inline size_t MultiMatcher::count(StringView text) const {
+    size_t total = 0;
+    for_each_match(text, [&total](size_t, size_t) { total++; });
+    return total;
+}
+
+}
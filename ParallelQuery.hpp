@@ -0,0 +1,262 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+#include "Concepts.hpp"
+#include "Query.hpp"
+#include "Vector.hpp"
+#include "LinkedList.hpp"
+#include "Scheduler.hpp"
+
+namespace gdamn::data {
+
+template<typename C>
+concept RandomAccessContainer = requires(C& container, size_t i) {
+    container[i];
+    { container.len() } -> std::convertible_to<size_t>;
+};
+
+enum class ParallelOrder {
+    Ordered,    /* to_vector/to_list keep the source order */
+    Unordered   /* Results come in whatever order the partitions finish */
+};
+
+/*
+ * Parallel version of Query over a random access source. The source is cut into partitions and every partition
+ * runs the whole fused where/select chain as a sequential Query on the shared Scheduler. Positional stages (take,
+ * skip, take_while) have no meaning per partition and are left to the sequential query.
+ * Reductions keep one partial per fixed partition and combine them front to back, so sum() over floating point
+ * gives the same result on every run. Ordered collection does the same with one buffer per partition; unordered
+ * collection lets the scheduler split the range as it likes and links each buffer in as soon as it is filled.
+ * Callbacks run concurrently on the worker threads.
+ */
+/* S is the source element type, T what the chain produces from it */
+template<typename T, typename S, typename Slicer, typename Chain>
+class ParallelQuery {
+public:
+    using value_type = T;
+
+    ParallelQuery(Slicer slicer, Chain chain, size_t size, size_t grain, ParallelOrder order)
+        : slicer(std::move(slicer)), chain(std::move(chain)), size(size), grain(grain), order(order) {}
+
+    auto as_ordered()   { return with_order(ParallelOrder::Ordered); }
+    auto as_unordered() { return with_order(ParallelOrder::Unordered); }
+
+    template<Predicate<T&> F>
+    auto where(F pred) {
+        return make<T>([chain = chain, pred](auto source) { return chain(std::move(source)).where(pred); });
+    }
+
+    template<Visitor<T&> F>
+    auto select(F fn) {
+        using U = std::decay_t<std::invoke_result_t<F&, T&>>;
+        return make<U>([chain = chain, fn](auto source) { return chain(std::move(source)).select(fn); });
+    }
+
+    /* Terminal operations */
+    template<Visitor<T&> F>
+    void for_each(F fn);
+
+    size_t count();
+    T sum();
+    T min(T fallback = T());
+    T max(T fallback = T());
+
+    Vector<T> to_vector();
+    LinkedList<T> to_list();
+
+private:
+    template<typename U, typename C>
+    ParallelQuery<U, S, Slicer, C> make(C next) {
+        return ParallelQuery<U, S, Slicer, C>(slicer, std::move(next), size, grain, order);
+    }
+
+    ParallelQuery with_order(ParallelOrder next) {
+        return ParallelQuery(slicer, chain, size, grain, next);
+    }
+
+    /* The fused chain over source elements [lo, hi) */
+    auto partition(size_t lo, size_t hi) {
+        auto producer = slicer(lo, hi);
+        return chain(Query<S, decltype(producer)>(std::move(producer)));
+    }
+
+    size_t partitions() const { return (size + grain - 1) / grain; }
+
+    /* Folds every partition into its own R starting from init, then combines the partials in partition order */
+    template<typename R, typename Step, typename Combine>
+    R reduce(R init, Step step, Combine combine);
+
+    Vector<T> collect_ordered();
+    Vector<T> collect_unordered();
+
+    template<typename, typename, typename, typename>
+    friend class ParallelQuery;
+
+    Slicer          slicer;
+    Chain           chain;
+    size_t          size;
+    size_t          grain;
+    ParallelOrder   order;
+};
+
+template<typename T, typename S, typename Slicer, typename Chain>
+template<Visitor<T&> F>
+void ParallelQuery<T, S, Slicer, Chain>::for_each(F fn) {
+    system::Scheduler::instance().parallel_for(0, size, grain, [&](size_t lo, size_t hi) {
+        partition(lo, hi).for_each(fn);
+    });
+}
+
+template<typename T, typename S, typename Slicer, typename Chain>
+template<typename R, typename Step, typename Combine>
+R ParallelQuery<T, S, Slicer, Chain>::reduce(R init, Step step, Combine combine) {
+    size_t n_parts = partitions();
+    Vector<R> partials;
+    partials.realign(n_parts);
+    for(size_t p = 0; p < n_parts; p++) partials.emplace_back(init);
+
+    system::Scheduler::instance().parallel_for(0, n_parts, 1, [&](size_t p) {
+        R acc = init; /* Local, so partitions don't fight over the cache lines of partials */
+        partition(p * grain, std::min(size, (p + 1) * grain)).for_each([&](T& val) { step(acc, val); });
+        partials[p] = std::move(acc);
+    });
+
+    R result = std::move(init);
+    for(size_t p = 0; p < n_parts; p++) combine(result, partials[p]);
+    return result;
+}
+
+template<typename T, typename S, typename Slicer, typename Chain>
+size_t ParallelQuery<T, S, Slicer, Chain>::count() {
+    return reduce<size_t>(0,
+        [](size_t& acc, T&) { acc++; },
+        [](size_t& result, size_t& part) { result += part; });
+}
+
+template<typename T, typename S, typename Slicer, typename Chain>
+T ParallelQuery<T, S, Slicer, Chain>::sum() {
+    return reduce<T>(T(),
+        [](T& acc, T& val) { acc += val; },
+        [](T& result, T& part) { result += part; });
+}
+
+template<typename T, typename S, typename Slicer, typename Chain>
+T ParallelQuery<T, S, Slicer, Chain>::min(T fallback) {
+    auto best = reduce<std::pair<bool, T>>({ false, T() },
+        [](std::pair<bool, T>& acc, T& val) {
+            if(!acc.first || val < acc.second) acc = { true, val };
+        },
+        [](std::pair<bool, T>& result, std::pair<bool, T>& part) {
+            if(part.first && (!result.first || part.second < result.second)) result = part;
+        });
+    return best.first ? best.second : fallback;
+}
+
+template<typename T, typename S, typename Slicer, typename Chain>
+T ParallelQuery<T, S, Slicer, Chain>::max(T fallback) {
+    auto best = reduce<std::pair<bool, T>>({ false, T() },
+        [](std::pair<bool, T>& acc, T& val) {
+            if(!acc.first || acc.second < val) acc = { true, val };
+        },
+        [](std::pair<bool, T>& result, std::pair<bool, T>& part) {
+            if(part.first && (!result.first || result.second < part.second)) result = part;
+        });
+    return best.first ? best.second : fallback;
+}
+
+template<typename T, typename S, typename Slicer, typename Chain>
+Vector<T> ParallelQuery<T, S, Slicer, Chain>::collect_ordered() {
+    size_t n_parts = partitions();
+    Vector<Vector<T>> parts;
+    parts.realign(n_parts);
+    for(size_t p = 0; p < n_parts; p++) parts.emplace_back();
+
+    system::Scheduler::instance().parallel_for(0, n_parts, 1, [&](size_t p) {
+        Vector<T>& out = parts[p];
+        partition(p * grain, std::min(size, (p + 1) * grain)).for_each([&](T& val) { out.emplace_back(val); });
+    });
+
+    size_t total = 0;
+    for(size_t p = 0; p < n_parts; p++) total += parts[p].len();
+    Vector<T> result;
+    result.realign(total);
+    for(size_t p = 0; p < n_parts; p++)
+        for(auto& val : parts[p]) result.emplace_back(std::move(val));
+    return result;
+}
+
+template<typename T, typename S, typename Slicer, typename Chain>
+Vector<T> ParallelQuery<T, S, Slicer, Chain>::collect_unordered() {
+    struct Part {
+        Vector<T>   items;
+        Part*       next = nullptr;
+    };
+    std::atomic<Part*> filled = nullptr;
+    std::atomic<size_t> total = 0;
+
+    system::Scheduler::instance().parallel_for(0, size, grain, [&](size_t lo, size_t hi) {
+        Part* part = new Part;
+        partition(lo, hi).for_each([&](T& val) { part->items.emplace_back(val); });
+        total.fetch_add(part->items.len(), std::memory_order_relaxed);
+        part->next = filled.load(std::memory_order_relaxed);
+        while(!filled.compare_exchange_weak(part->next, part, std::memory_order_release, std::memory_order_relaxed));
+    });
+
+    /* parallel_for has joined every task, so the list is complete */
+    Vector<T> result;
+    result.realign(total.load(std::memory_order_relaxed));
+    for(Part* part = filled.load(std::memory_order_acquire); part != nullptr;) {
+        for(auto& val : part->items) result.emplace_back(std::move(val));
+        Part* next = part->next;
+        delete part;
+        part = next;
+    }
+    return result;
+}
+
+template<typename T, typename S, typename Slicer, typename Chain>
+Vector<T> ParallelQuery<T, S, Slicer, Chain>::to_vector() {
+    if(size == 0) return Vector<T>();
+    return order == ParallelOrder::Ordered ? collect_ordered() : collect_unordered();
+}
+
+template<typename T, typename S, typename Slicer, typename Chain>
+LinkedList<T> ParallelQuery<T, S, Slicer, Chain>::to_list() {
+    LinkedList<T> list;
+    for(auto& val : to_vector()) list.emplace_back(std::move(val));
+    return list;
+}
+
+/*
+ * Starts a parallel query over container, which is read in place and must not change while the query runs.
+ * grain is the number of source elements per partition, 0 picks one that gives every worker a few partitions.
+ */
+template<RandomAccessContainer C>
+auto as_parallel(C& container, size_t grain = 0, ParallelOrder order = ParallelOrder::Ordered) {
+    using S = std::remove_cv_t<std::remove_reference_t<decltype(container[0])>>;
+
+    struct Slicer {
+        auto operator()(size_t lo, size_t hi) const {
+            return [source = source, lo, hi](auto&& sink) {
+                for(size_t i = lo; i < hi; i++)
+                    if(!sink((*source)[i])) return false;
+                return true;
+            };
+        }
+        C* source;
+    };
+
+    size_t size = container.len();
+    if(grain == 0) {
+        size_t slots = system::Scheduler::instance().workers() * 4;
+        grain = std::max<size_t>((size + slots - 1) / slots, 1024);
+    }
+    auto chain = [](auto source) { return source; };
+    return ParallelQuery<S, S, Slicer, decltype(chain)>(Slicer{ &container }, chain, size, grain, order);
+}
+
+}
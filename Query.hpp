@@ -0,0 +1,151 @@
+#pragma once
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+#include "Concepts.hpp"
+#include "LinkedList.hpp"
+#include "Vector.hpp"
+
+namespace gdamn::data {
+
+/*
+ * Lazy query over a container. Every operator wraps the producer of the previous stage, so nothing runs until a
+ * terminal operation (for_each, count, any, first_or_default, to_vector, to_list) pushes the source through the
+ * whole chain in one fused loop. A producer is called with a sink that returns false to stop, which is how take,
+ * take_while, any and first_or_default finish early. Stages keep their state per run, so a query can be re-run;
+ * it refers to its source container, which has to outlive it.
+ */
+template<typename T, typename Producer>
+class Query {
+public:
+    using value_type = T;
+
+    explicit Query(Producer producer) : producer(std::move(producer)) {}
+
+    template<Predicate<T&> F>
+    auto where(F pred) {
+        return make<T>([producer = producer, pred](auto&& sink) mutable {
+            return producer([&](auto&& val) { return !pred(val) || sink(std::forward<decltype(val)>(val)); });
+        });
+    }
+
+    template<Visitor<T&> F>
+    auto select(F fn) {
+        using U = std::decay_t<std::invoke_result_t<F&, T&>>;
+        return make<U>([producer = producer, fn](auto&& sink) mutable {
+            return producer([&](auto&& val) { return sink(fn(val)); });
+        });
+    }
+
+    auto take(size_t count) {
+        return make<T>([producer = producer, count](auto&& sink) mutable {
+            if(count == 0) return true;
+            size_t left = count;
+            return producer([&](auto&& val) { return sink(std::forward<decltype(val)>(val)) && --left != 0; }) || left == 0;
+        });
+    }
+
+    auto skip(size_t count) {
+        return make<T>([producer = producer, count](auto&& sink) mutable {
+            size_t skipped = 0;
+            return producer([&](auto&& val) {
+                if(skipped < count) { skipped++; return true; }
+                return sink(std::forward<decltype(val)>(val));
+            });
+        });
+    }
+
+    template<Predicate<T&> F>
+    auto take_while(F pred) {
+        return make<T>([producer = producer, pred](auto&& sink) mutable {
+            bool stopped = false;
+            return producer([&](auto&& val) {
+                if(!pred(val)) { stopped = true; return false; }
+                return sink(std::forward<decltype(val)>(val));
+            }) || stopped;
+        });
+    }
+
+    /* Terminal operations */
+    template<Visitor<T&> F>
+    void for_each(F fn) {
+        producer([&](auto&& val) { fn(val); return true; });
+    }
+
+    T first_or_default(T fallback = T()) {
+        producer([&](auto&& val) { fallback = std::forward<decltype(val)>(val); return false; });
+        return fallback;
+    }
+
+    bool any() {
+        bool found = false;
+        producer([&](auto&&) { found = true; return false; });
+        return found;
+    }
+
+    template<Predicate<T&> F>
+    bool any(F pred) {
+        return where(std::move(pred)).any();
+    }
+
+    size_t count() {
+        size_t total = 0;
+        producer([&](auto&&) { total++; return true; });
+        return total;
+    }
+
+    Vector<T> to_vector() {
+        Vector<T> vector;
+        producer([&](auto&& val) { vector.insert(T(std::forward<decltype(val)>(val))); return true; });
+        return vector;
+    }
+
+    LinkedList<T> to_list() {
+        LinkedList<T> list;
+        producer([&](auto&& val) { list.emplace_back(std::forward<decltype(val)>(val)); return true; });
+        return list;
+    }
+
+private:
+    template<typename U, typename P>
+    static Query<U, P> make(P producer) { return Query<U, P>(std::move(producer)); }
+
+    template<typename, typename>
+    friend class Query;
+
+    Producer producer;
+};
+
+/* Containers with contiguous runs (Deque) are walked segment by segment, everything else with its iterators */
+template<typename C>
+using element_t = std::remove_reference_t<decltype(*std::declval<C&>().begin())>;
+
+template<typename C>
+concept SegmentedContainer = requires(C& container, bool (*visit)(element_t<C>*, size_t)) {
+    container.for_each_segment(visit);
+};
+
+/* Starts a lazy query over container, which is read in place */
+template<typename C>
+auto query(C& container) {
+    using T = std::remove_cv_t<element_t<C>>;
+
+    auto producer = [source = &container](auto&& sink) {
+        if constexpr(SegmentedContainer<C>) {
+            bool completed = true;
+            source->for_each_segment([&](auto* data, size_t count) {
+                for(size_t i = 0; i < count; i++)
+                    if(!sink(data[i])) return completed = false;
+                return true;
+            });
+            return completed;
+        } else {
+            for(auto& val : *source)
+                if(!sink(val)) return false;
+            return true;
+        }
+    };
+    return Query<T, decltype(producer)>(std::move(producer));
+}
+
+}
@@ -0,0 +1,209 @@
+#pragma once
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+#include "WorkStealingDeque.hpp"
+#include "MpmcQueue.hpp"
+#include "Random.hpp"
+
+namespace gdamn::system {
+
+class Scheduler;
+
+/* Counts the tasks spawned into it that haven't finished yet */
+class TaskGroup {
+public:
+    TaskGroup() {}
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    bool done() const { return pending.load(std::memory_order_acquire) == 0; }
+
+private:
+    std::atomic<size_t> pending = 0;
+    friend Scheduler;
+};
+
+/*
+ * Work-stealing thread pool. Every worker owns a Chase-Lev deque: tasks it spawns go to its own bottom and
+ * idle workers steal from the top of a random victim. Threads outside the pool submit through a shared queue.
+ * wait() doesn't block the caller, it keeps executing tasks until the group is done.
+ */
+class Scheduler {
+private:
+    struct Task {
+        virtual ~Task() {}
+        virtual void run() = 0;
+        TaskGroup* group = nullptr;
+    };
+
+    template<typename F>
+    struct CallableTask : Task {
+        CallableTask(F&& fn) : fn(std::forward<F>(fn)) {}
+        void run() override { fn(); }
+        std::decay_t<F> fn;
+    };
+
+    struct Worker {
+        Worker(size_t index) : rng(index * 2654435761u + 1) {}
+        data::WorkStealingDeque<Task*>  tasks;
+        LCGU64                          rng;
+        std::thread                     thread;
+    };
+
+public:
+    explicit Scheduler(size_t n_workers = std::thread::hardware_concurrency());
+    ~Scheduler();
+
+    Scheduler(const Scheduler&) = delete;
+    Scheduler& operator=(const Scheduler&) = delete;
+
+    /* Process wide pool shared by every container operation */
+    static Scheduler& instance() {
+        static Scheduler scheduler;
+        return scheduler;
+    }
+
+    template<typename F>
+    void spawn(TaskGroup& group, F&& fn);
+    void wait(TaskGroup& group);
+
+    /* Calls fn(lo, hi) on disjoint sub-ranges of [begin, end) no larger than grain, or fn(i) for every index */
+    template<typename F>
+    void parallel_for(size_t begin, size_t end, size_t grain, F&& fn);
+
+    size_t workers() const { return n_workers; }
+
+private:
+    void worker_loop(size_t index);
+    bool run_one(Worker* self);
+    void execute(Task* task);
+
+    template<typename F>
+    void split(TaskGroup& group, size_t begin, size_t end, size_t grain, F& fn);
+
+    size_t                          n_workers = 0;
+    std::unique_ptr<Worker>*        worker_list = nullptr;
+    data::MpmcQueue<Task*>          injected;
+    std::atomic<bool>               running = true;
+    alignas(64) std::atomic<size_t> epoch = 0;     /* Bumped on every spawn, idle workers sleep on it */
+    std::atomic<size_t>             sleepers = 0;
+
+    inline static thread_local Worker*    current_worker = nullptr;
+    inline static thread_local Scheduler* current_scheduler = nullptr;
+};
+
+inline Scheduler::Scheduler(size_t n_workers) : injected(1024) {
+    this->n_workers = std::max<size_t>(n_workers, 1);
+    worker_list = new std::unique_ptr<Worker>[this->n_workers];
+    for(size_t i = 0; i < this->n_workers; i++)
+        worker_list[i] = std::make_unique<Worker>(i);
+    for(size_t i = 0; i < this->n_workers; i++)
+        worker_list[i]->thread = std::thread([this, i]() { worker_loop(i); });
+}
+
+inline Scheduler::~Scheduler() {
+    running.store(false, std::memory_order_release);
+    epoch.fetch_add(1, std::memory_order_release);
+    epoch.notify_all();
+    for(size_t i = 0; i < n_workers; i++) worker_list[i]->thread.join();
+
+    /* Tasks nobody waited for are dropped */
+    Task* task = nullptr;
+    for(size_t i = 0; i < n_workers; i++)
+        while(worker_list[i]->tasks.pop(task)) delete task;
+    while(injected.try_pop(task)) delete task;
+    delete[] worker_list;
+}
+
+template<typename F>
+void Scheduler::spawn(TaskGroup& group, F&& fn) {
+    Task* task = new CallableTask<F>(std::forward<F>(fn));
+    task->group = &group;
+    group.pending.fetch_add(1, std::memory_order_relaxed);
+
+    if(current_scheduler == this)       current_worker->tasks.push(task);
+    else if(!injected.try_push(task))   { execute(task); return; } /* Submission queue is full, run inline */
+
+    /* seq_cst pairs with the sleeper registration in worker_loop, so one side always sees the other */
+    epoch.fetch_add(1);
+    if(sleepers.load() > 0) epoch.notify_one();
+}
+
+inline void Scheduler::wait(TaskGroup& group) {
+    Worker* self = current_scheduler == this ? current_worker : nullptr;
+    while(!group.done())
+        if(!run_one(self)) std::this_thread::yield();
+}
+
+inline void Scheduler::execute(Task* task) {
+    TaskGroup* group = task->group;
+    task->run();
+    delete task;
+    group->pending.fetch_sub(1, std::memory_order_release);
+}
+
+/* Own deque first (LIFO, still cache-hot), then the submission queue, then one round of random victims */
+inline bool Scheduler::run_one(Worker* self) {
+    Task* task = nullptr;
+    if(self != nullptr && self->tasks.pop(task)) { execute(task); return true; }
+    if(injected.try_pop(task)) { execute(task); return true; }
+
+    size_t start = self != nullptr ? (size_t)(self->rng.next() >> 32) : 0;
+    for(size_t i = 0; i < n_workers; i++) {
+        Worker* victim = worker_list[(start + i) % n_workers].get();
+        if(victim != self && victim->tasks.steal(task)) { execute(task); return true; }
+    }
+    return false;
+}
+
+inline void Scheduler::worker_loop(size_t index) {
+    current_worker = worker_list[index].get();
+    current_scheduler = this;
+
+    while(running.load(std::memory_order_acquire)) {
+        size_t seen = epoch.load(std::memory_order_acquire);
+        if(run_one(current_worker)) continue;
+
+        bool found = false;
+        for(size_t spins = 0; spins < 64 && !found; spins++) {
+            std::this_thread::yield();
+            found = run_one(current_worker);
+        }
+        if(found) continue;
+
+        /* Nothing spawned since seen means nothing to steal, sleep until the next spawn */
+        sleepers.fetch_add(1);
+        if(running.load(std::memory_order_acquire)) epoch.wait(seen);
+        sleepers.fetch_sub(1);
+    }
+}
+
+template<typename F>
+void Scheduler::split(TaskGroup& group, size_t begin, size_t end, size_t grain, F& fn) {
+    /* Hand the upper halves to thieves and keep descending into the lower one */
+    while(end - begin > grain) {
+        size_t mid = begin + (end - begin) / 2;
+        spawn(group, [this, &group, mid, end, grain, &fn]() { split(group, mid, end, grain, fn); });
+        end = mid;
+    }
+
+    if constexpr(std::is_invocable_v<F&, size_t, size_t>) {
+        fn(begin, end);
+    } else {
+        for(size_t i = begin; i < end; i++) fn(i);
+    }
+}
+
+template<typename F>
+void Scheduler::parallel_for(size_t begin, size_t end, size_t grain, F&& fn) {
+    if(begin >= end) return;
+    TaskGroup group;
+    split(group, begin, end, std::max<size_t>(grain, 1), fn);
+    wait(group);
+}
+
+}
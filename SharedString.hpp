@@ -0,0 +1,163 @@
+#pragma once
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <ostream>
+#include <utility>
+#include "String.hpp"
+
+namespace gdamn::data {
+
+/*
+ * Immutable string whose copies share one payload through an atomic reference count, so copying into many
+ * containers costs an increment instead of an allocation. Reading is safe from any thread; the only way to
+ * change the contents is mutable_data(), which copies the payload first if anyone else still holds it.
+ */
+class SharedString {
+private:
+    struct Payload {
+        std::atomic<size_t> refs;
+        size_t              size;
+        /* size characters and a terminator follow the header */
+        char* chars() { return reinterpret_cast<char*>(this + 1); }
+    };
+
+public:
+    SharedString() {}
+    SharedString(const char* str) : SharedString(StringView(str)) {}
+    SharedString(const char* str, size_t count) : SharedString(StringView(str, count)) {}
+    explicit SharedString(StringView str);
+    template<size_t n>
+    explicit SharedString(const BasicString<n>& str) : SharedString(str.view()) {}
+
+    SharedString(const SharedString& other) : payload(other.payload) { retain(); }
+    SharedString(SharedString&& other) : payload(std::exchange(other.payload, nullptr)) {}
+    ~SharedString() { release(); }
+
+    SharedString& operator=(const SharedString& other) {
+        if(payload == other.payload) return *this;
+        release();
+        payload = other.payload;
+        retain();
+        return *this;
+    }
+
+    SharedString& operator=(SharedString&& other) {
+        if(this == &other) return *this;
+        release();
+        payload = std::exchange(other.payload, nullptr);
+        return *this;
+    }
+
+    const char* data() const    { return payload != nullptr ? payload->chars() : ""; }
+    const char* c_str() const   { return data(); }
+    size_t len() const          { return payload != nullptr ? payload->size : 0; }
+    bool empty() const          { return len() == 0; }
+    char operator[](size_t i) const { return payload->chars()[i]; }
+
+    StringView view() const     { return StringView(data(), len()); }
+    operator StringView() const { return view(); }
+
+    /* Owning, independently mutable copy */
+    template<size_t n = 16>
+    BasicString<n> to_string() const { return BasicString<n>(view()); }
+
+    /* Copy-on-write: detaches from the other holders first, so the characters can be changed in place */
+    char* mutable_data();
+    /* Builds the concatenation in a fresh payload, the old one stays intact for its other holders */
+    void append(StringView str);
+
+    /* Holders of this payload, this one included; 0 for the empty string */
+    size_t use_count() const    { return payload != nullptr ? payload->refs.load(std::memory_order_relaxed) : 0; }
+    bool unique() const         { return use_count() == 1; }
+
+    /* Copies that still share a payload compare equal without looking at the characters */
+    bool operator==(const SharedString& other) const { return payload == other.payload || view() == other.view(); }
+    bool operator!=(const SharedString& other) const { return !(*this == other); }
+    bool operator==(StringView other) const          { return view() == other; }
+    bool operator!=(StringView other) const          { return view() != other; }
+    bool operator==(const char* other) const         { return view() == StringView(other); }
+    bool operator!=(const char* other) const         { return view() != StringView(other); }
+    bool operator<(const SharedString& other) const  { return view() < other.view(); }
+
+    friend std::ostream& operator<<(std::ostream& os, const SharedString& str) {
+        return os << str.view();
+    }
+
+private:
+    static Payload* allocate(size_t size);
+
+    void retain() {
+        if(payload != nullptr) payload->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /* acq_rel so the last holder sees every other holder's reads finished before it frees */
+    void release() {
+        if(payload != nullptr && payload->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            payload->~Payload();
+            ::operator delete(payload);
+        }
+        payload = nullptr;
+    }
+
+    Payload* payload = nullptr;
+};
+
+inline SharedString::Payload* SharedString::allocate(size_t size) {
+    Payload* created = new (::operator new(sizeof(Payload) + size + 1)) Payload;
+    created->refs.store(1, std::memory_order_relaxed);
+    created->size = size;
+    created->chars()[size] = '\0';
+    return created;
+}
+
+inline SharedString::SharedString(StringView str) {
+    if(str.empty()) return;
+    payload = allocate(str.len());
+    std::memcpy(payload->chars(), str.data(), str.len());
+}
+
+inline char* SharedString::mutable_data() {
+    if(payload == nullptr) return nullptr;
+    if(payload->refs.load(std::memory_order_acquire) != 1) {
+        Payload* copy = allocate(payload->size);
+        std::memcpy(copy->chars(), payload->chars(), payload->size);
+        release();
+        payload = copy;
+    }
+    return payload->chars();
+}
+
+inline void SharedString::append(StringView str) {
+    if(str.empty()) return;
+    size_t size = len();
+    Payload* joined = allocate(size + str.len());
+    if(size != 0) std::memcpy(joined->chars(), payload->chars(), size);
+    std::memcpy(joined->chars() + size, str.data(), str.len()); /* str may view our old payload, which is still alive */
+    release();
+    payload = joined;
+}
+
+}
+
+namespace std {
+    template <>
+    struct hash<gdamn::data::SharedString> {
+        /* Lets HashTable look SharedString keys up by StringView, same FNV-1a as every other string type */
+        using is_transparent = void;
+
+        size_t operator()(const gdamn::data::SharedString& str) const {
+            return gdamn::data::hash_bytes(str.data(), str.len());
+        }
+
+        size_t operator()(gdamn::data::StringView str) const {
+            return gdamn::data::hash_bytes(str.data(), str.len());
+        }
+
+        /* Literals convert to both overloads above, this one keeps them from picking a temporary string */
+        size_t operator()(const char* str) const {
+            return gdamn::data::hash_bytes(str, std::strlen(str));
+        }
+    };
+}
@@ -0,0 +1,263 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <utility>
+#include "Enumerable.hpp"
+#include "Random.hpp"
+
+namespace gdamn::data {
+
+/*
+ * Ordered map with O(log n) insert, find and remove.
+ * Keys are ordered by operator<, nodes carry a tower of forward links whose height is drawn with p = 1/4.
+ */
+template<typename K, typename V, size_t max_level = 16>
+class SkipList {
+private:
+    struct Node {
+        std::pair<K, V> data;
+        size_t level = 0;
+
+        /* The forward links are allocated right behind the node */
+        Node** next() { return reinterpret_cast<Node**>(this + 1); }
+    };
+
+public:
+    SkipList();
+    ~SkipList();
+
+    SkipList(const SkipList&) = delete;
+    SkipList& operator=(const SkipList&) = delete;
+
+    SkipList(SkipList&& other) {
+        for(size_t i = 0; i < max_level; i++) {
+            this->head[i] = other.head[i];
+            other.head[i] = nullptr;
+        }
+        this->level = other.level;
+        this->length = other.length;
+        other.level = 1;
+        other.length = 0;
+    }
+
+    class Iterator {
+    public:
+        Iterator() {}
+
+        Iterator(const Iterator& itr) {
+            this->curr_node = itr.curr_node;
+        }
+
+        Iterator& operator=(const Iterator& other) {
+            this->curr_node = other.curr_node;
+            return *this;
+        }
+
+        Iterator& operator++() {
+            curr_node = curr_node->next()[0];
+            return *this;
+        }
+
+        Iterator& operator++(int) {
+            curr_node = curr_node->next()[0];
+            return *this;
+        }
+
+        bool operator==(const Iterator other) const {
+            return this->curr_node == other.curr_node;
+        }
+
+        bool operator!=(const Iterator other) const {
+            return !(*this == other);
+        }
+
+        std::pair<K, V>& operator*() {
+            return curr_node->data;
+        }
+
+    private:
+        Iterator(Node* node) { this->curr_node = node; }
+
+        Node* curr_node = nullptr;
+        friend SkipList;
+    };
+
+    /* Half-open view [lo, hi) over the list, nothing is copied */
+    class Range {
+    public:
+        Iterator begin() { return first; }
+        Iterator end()   { return Iterator(stop); }
+
+    private:
+        Range(Iterator first, Node* stop) : first(first), stop(stop) {}
+
+        Iterator first;
+        Node* stop = nullptr;
+        friend SkipList;
+    };
+
+    void insert(std::pair<K, V>& key_pair);
+    void insert(std::pair<K, V>&& key_pair);
+
+    void remove(const K& key);
+
+    Iterator find(const K& key);
+    Iterator lower_bound(const K& key);
+    Range range(const K& lo, const K& hi);
+    bool contains(const K& key);
+
+    template<Visitor<const K&, V&> F>
+    void for_each(F call_back);
+    template<Predicate<const K&, const V&> F>
+    Enumerable<std::pair<K, V>> where(F match_func);
+
+    V& operator[](const K& key);
+
+    std::pair<K, V>& first()    { return head[0]->data; }
+    size_t len() const          { return length; }
+    Iterator begin()            { return Iterator(head[0]); }
+    Iterator end()              { return Iterator(nullptr); }
+
+private:
+    size_t random_level();
+    Node* find_node(const K& key, Node** update[max_level]);
+    Node* link(std::pair<K, V>&& key_pair, Node** update[max_level]);
+
+    Node*           head[max_level] = {};
+    size_t          level = 1;
+    size_t          length = 0;
+    system::LCGU64  rng;
+};
+
+template<typename K, typename V, size_t max_level>
+SkipList<K, V, max_level>::SkipList() : rng((size_t)this) {}
+
+template<typename K, typename V, size_t max_level>
+SkipList<K, V, max_level>::~SkipList() {
+    Node* itr = head[0];
+    while(itr != nullptr) {
+        Node* del = itr;
+        itr = itr->next()[0];
+        del->~Node();
+        operator delete(del);
+    }
+}
+
+template<typename K, typename V, size_t max_level>
+size_t SkipList<K, V, max_level>::random_level() {
+    /* The low bits of an LCG are weak, draw the tower height from the top ones */
+    uint64_t bits = rng.next() >> 32;
+    size_t lvl = 1;
+    while(lvl < max_level && (bits & 3) == 0) {
+        lvl++;
+        bits >>= 2;
+    }
+    return lvl;
+}
+
+/*
+ * Walks down the towers and returns the first node with key >= the searched one.
+ * If update is given it receives, per level, the link that has to be rewired to splice in front of that node.
+ */
+template<typename K, typename V, size_t max_level>
+typename SkipList<K, V, max_level>::Node* SkipList<K, V, max_level>::find_node(const K& key, Node** update[max_level]) {
+    Node** links = head;
+    for(size_t i = level; i-- > 0;) {
+        while(links[i] != nullptr && links[i]->data.first < key)
+            links = links[i]->next();
+        if(update != nullptr) update[i] = &links[i];
+    }
+    return links[0];
+}
+
+template<typename K, typename V, size_t max_level>
+typename SkipList<K, V, max_level>::Node* SkipList<K, V, max_level>::link(std::pair<K, V>&& key_pair, Node** update[max_level]) {
+    size_t node_level = random_level();
+    for(; level < node_level; level++) update[level] = &head[level];
+
+    void* mem = operator new(sizeof(Node) + node_level * sizeof(Node*));
+    Node* node = new (mem) Node{ std::move(key_pair), node_level };
+    for(size_t i = 0; i < node_level; i++) {
+        node->next()[i] = *update[i];
+        *update[i] = node;
+    }
+    length++;
+    return node;
+}
+
+template<typename K, typename V, size_t max_level>
+void SkipList<K, V, max_level>::insert(std::pair<K, V>& key_pair) {
+    insert(std::pair<K, V>(key_pair));
+}
+
+template<typename K, typename V, size_t max_level>
+void SkipList<K, V, max_level>::insert(std::pair<K, V>&& key_pair) {
+    Node** update[max_level];
+    Node* found = find_node(key_pair.first, update);
+    if(found != nullptr && !(key_pair.first < found->data.first)) return; /* Key already present */
+    link(std::move(key_pair), update);
+}
+
+template<typename K, typename V, size_t max_level>
+void SkipList<K, V, max_level>::remove(const K& key) {
+    Node** update[max_level];
+    Node* found = find_node(key, update);
+    if(found == nullptr || key < found->data.first) return;
+
+    for(size_t i = 0; i < found->level; i++)
+        *update[i] = found->next()[i];
+    while(level > 1 && head[level - 1] == nullptr) level--;
+
+    found->~Node();
+    operator delete(found);
+    length--;
+}
+
+template<typename K, typename V, size_t max_level>
+typename SkipList<K, V, max_level>::Iterator SkipList<K, V, max_level>::find(const K& key) {
+    Node* found = find_node(key, nullptr);
+    if(found == nullptr || key < found->data.first) return end();
+    return Iterator(found);
+}
+
+template<typename K, typename V, size_t max_level>
+typename SkipList<K, V, max_level>::Iterator SkipList<K, V, max_level>::lower_bound(const K& key) {
+    return Iterator(find_node(key, nullptr));
+}
+
+template<typename K, typename V, size_t max_level>
+typename SkipList<K, V, max_level>::Range SkipList<K, V, max_level>::range(const K& lo, const K& hi) {
+    if(!(lo < hi)) return Range(end(), nullptr);
+    return Range(lower_bound(lo), find_node(hi, nullptr));
+}
+
+template<typename K, typename V, size_t max_level>
+bool SkipList<K, V, max_level>::contains(const K& key) {
+    return find(key) != end();
+}
+
+template<typename K, typename V, size_t max_level>
+template<Visitor<const K&, V&> F>
+void SkipList<K, V, max_level>::for_each(F call_back) {
+    for(auto& [k, v] : *this) call_back(k, v);
+}
+
+template<typename K, typename V, size_t max_level>
+template<Predicate<const K&, const V&> F>
+Enumerable<std::pair<K, V>> SkipList<K, V, max_level>::where(F match_func) {
+    Enumerable<std::pair<K, V>> enumerable;
+    for(auto& pair : *this)
+        if(match_func(pair.first, pair.second)) enumerable.insert(pair);
+    return enumerable;
+}
+
+template<typename K, typename V, size_t max_level>
+V& SkipList<K, V, max_level>::operator[](const K& key) {
+    Node** update[max_level];
+    Node* found = find_node(key, update);
+    if(found != nullptr && !(key < found->data.first)) return found->data.second;
+    return link({ key, V() }, update)->data.second;
+}
+
+}
@@ -0,0 +1,110 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+#include "Deque.hpp"
+
+namespace gdamn::data {
+
+/* Aggregation operators for SlidingWindow, any associative operator with an identity works */
+template<typename T>
+struct MinOp {
+    static T identity()                         { return std::numeric_limits<T>::max(); }
+    T operator()(const T& a, const T& b) const  { return b < a ? b : a; }
+};
+
+template<typename T>
+struct MaxOp {
+    static T identity()                         { return std::numeric_limits<T>::lowest(); }
+    T operator()(const T& a, const T& b) const  { return a < b ? b : a; }
+};
+
+template<typename T>
+struct SumOp {
+    static T identity()                         { return T(); }
+    T operator()(const T& a, const T& b) const  { return a + b; }
+};
+
+/*
+ * Rolling aggregate over the most recent values, evicted by count, by age or both.
+ * Uses two-stack aggregation on top of a single Deque: the older part of the window stores suffix
+ * aggregates, the newer part is folded into one running value. When the older part runs dry the suffixes
+ * are rebuilt once, so push, evict and query are all O(1) amortized and Op doesn't need an inverse.
+ */
+template<typename T, typename Op = SumOp<T>>
+class SlidingWindow {
+private:
+    struct Entry {
+        T       value;
+        T       suffix;     /* op over value .. the end of the older part, only valid below boundary */
+        int64_t timestamp;
+    };
+
+public:
+    /* max_count / max_age of 0 disable that eviction rule; ages use the caller's timestamp unit */
+    explicit SlidingWindow(size_t max_count = 0, int64_t max_age = 0) : max_count(max_count), max_age(max_age) {}
+
+    void push(const T& value, int64_t timestamp = 0);
+    void evict_before(int64_t timestamp);   /* Drops every value older than timestamp */
+    void pop_front();
+
+    T query();
+    size_t len()    { return entries.len(); }
+    bool empty()    { return entries.len() == 0; }
+    T& first()      { return entries.first().value; }
+    T& last()       { return entries.last().value; }
+
+private:
+    void rebuild();
+
+    Deque<Entry>    entries;
+    size_t          boundary = 0;               /* entries [0, boundary) carry suffix aggregates */
+    T               back_agg = Op::identity();  /* op over entries [boundary, len) */
+    size_t          max_count = 0;
+    int64_t         max_age = 0;
+    Op              op;
+};
+
+template<typename T, typename Op>
+void SlidingWindow<T, Op>::push(const T& value, int64_t timestamp) {
+    entries.emplace_back(Entry{ value, value, timestamp });
+    back_agg = op(back_agg, value);
+
+    if(max_count != 0)
+        while(entries.len() > max_count) pop_front();
+    if(max_age != 0)
+        evict_before(timestamp - max_age + 1);
+}
+
+template<typename T, typename Op>
+void SlidingWindow<T, Op>::evict_before(int64_t timestamp) {
+    while(entries.len() > 0 && entries.first().timestamp < timestamp) pop_front();
+}
+
+template<typename T, typename Op>
+void SlidingWindow<T, Op>::pop_front() {
+    if(entries.len() == 0) return;
+    if(boundary == 0) rebuild();
+    entries.pop_front();
+    boundary--;
+}
+
+template<typename T, typename Op>
+T SlidingWindow<T, Op>::query() {
+    if(boundary == 0) return back_agg;
+    return op(entries.first().suffix, back_agg);
+}
+
+/* Turns the whole window into the older part, folding the suffixes from the newest value backwards */
+template<typename T, typename Op>
+void SlidingWindow<T, Op>::rebuild() {
+    T agg = Op::identity();
+    for(size_t i = entries.len(); i-- > 0;) {
+        Entry& entry = entries[i];
+        agg = op(entry.value, agg);
+        entry.suffix = agg;
+    }
+    boundary = entries.len();
+    back_agg = Op::identity();
+}
+
+}
@@ -0,0 +1,176 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <algorithm>
+
+namespace gdamn::data {
+
+/*
+ * Bounded single-producer / single-consumer ring.
+ * Both indices only ever grow and are masked on access; each side keeps a private copy of the
+ * other side's index so the shared cache line is only touched when the ring looks full or empty.
+ * try_* calls are wait-free, push/pop spin briefly and then sleep on the opposite index.
+ */
+template<typename T, size_t Capacity>
+class SpscRing {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity has to be a power of two");
+
+public:
+    SpscRing() {}
+    ~SpscRing();
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    /* Producer side */
+    bool try_push(const T& val)     { return try_emplace(val); }
+    bool try_push(T&& val)          { return try_emplace(std::move(val)); }
+    template<typename... Args>
+    bool try_emplace(Args&&... args);
+    size_t try_push_n(const T* src, size_t count);
+    void push(const T& val);
+    void push(T&& val);
+
+    /* Consumer side */
+    bool try_pop(T& out);
+    size_t try_pop_n(T* dst, size_t count);
+    void pop(T& out);
+
+    size_t len() const {
+        return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+    }
+    bool empty() const                  { return len() == 0; }
+    constexpr size_t capacity() const   { return Capacity; }
+
+private:
+    T* slot(size_t i) { return std::launder(reinterpret_cast<T*>(storage + (i & (Capacity - 1)) * sizeof(T))); }
+
+    size_t free_slots();
+    size_t used_slots();
+    void wait_for_space();
+    void wait_for_data();
+
+    alignas(64) std::atomic<size_t> head = 0;   /* Next slot to pop, written by the consumer */
+    size_t cached_tail = 0;                     /* Consumer's copy of tail */
+    alignas(64) std::atomic<size_t> tail = 0;   /* Next slot to push, written by the producer */
+    size_t cached_head = 0;                     /* Producer's copy of head */
+    alignas(64) alignas(T) unsigned char storage[Capacity * sizeof(T)];
+};
+
+template<typename T, size_t Capacity>
+SpscRing<T, Capacity>::~SpscRing() {
+    size_t end = tail.load(std::memory_order_relaxed);
+    for(size_t i = head.load(std::memory_order_relaxed); i != end; i++)
+        slot(i)->~T();
+}
+
+template<typename T, size_t Capacity>
+size_t SpscRing<T, Capacity>::free_slots() {
+    size_t pos = tail.load(std::memory_order_relaxed);
+    if(pos - cached_head == Capacity)
+        cached_head = head.load(std::memory_order_acquire);
+    return Capacity - (pos - cached_head);
+}
+
+template<typename T, size_t Capacity>
+size_t SpscRing<T, Capacity>::used_slots() {
+    size_t pos = head.load(std::memory_order_relaxed);
+    if(pos == cached_tail)
+        cached_tail = tail.load(std::memory_order_acquire);
+    return cached_tail - pos;
+}
+
+template<typename T, size_t Capacity>
+template<typename... Args>
+bool SpscRing<T, Capacity>::try_emplace(Args&&... args) {
+    if(free_slots() == 0) return false;
+
+    size_t pos = tail.load(std::memory_order_relaxed);
+    new (slot(pos)) T(std::forward<Args>(args)...);
+    tail.store(pos + 1, std::memory_order_release);
+    tail.notify_one();
+    return true;
+}
+
+template<typename T, size_t Capacity>
+size_t SpscRing<T, Capacity>::try_push_n(const T* src, size_t count) {
+    count = std::min(count, free_slots());
+    if(count == 0) return 0;
+
+    size_t pos = tail.load(std::memory_order_relaxed);
+    for(size_t i = 0; i < count; i++)
+        new (slot(pos + i)) T(src[i]);
+    tail.store(pos + count, std::memory_order_release); /* Publish the whole batch at once */
+    tail.notify_one();
+    return count;
+}
+
+template<typename T, size_t Capacity>
+bool SpscRing<T, Capacity>::try_pop(T& out) {
+    if(used_slots() == 0) return false;
+
+    size_t pos = head.load(std::memory_order_relaxed);
+    out = std::move(*slot(pos));
+    slot(pos)->~T();
+    head.store(pos + 1, std::memory_order_release);
+    head.notify_one();
+    return true;
+}
+
+template<typename T, size_t Capacity>
+size_t SpscRing<T, Capacity>::try_pop_n(T* dst, size_t count) {
+    count = std::min(count, used_slots());
+    if(count == 0) return 0;
+
+    size_t pos = head.load(std::memory_order_relaxed);
+    for(size_t i = 0; i < count; i++) {
+        dst[i] = std::move(*slot(pos + i));
+        slot(pos + i)->~T();
+    }
+    head.store(pos + count, std::memory_order_release);
+    head.notify_one();
+    return count;
+}
+
+/* Spin for a short while first, the other side is usually only a few hundred cycles behind */
+template<typename T, size_t Capacity>
+void SpscRing<T, Capacity>::wait_for_space() {
+    for(size_t spins = 0; free_slots() == 0; spins++) {
+        if(spins < 128) continue;
+        size_t seen = head.load(std::memory_order_acquire);
+        if(tail.load(std::memory_order_relaxed) - seen == Capacity)
+            head.wait(seen, std::memory_order_acquire);
+    }
+}
+
+template<typename T, size_t Capacity>
+void SpscRing<T, Capacity>::wait_for_data() {
+    for(size_t spins = 0; used_slots() == 0; spins++) {
+        if(spins < 128) continue;
+        size_t seen = tail.load(std::memory_order_acquire);
+        if(seen == head.load(std::memory_order_relaxed))
+            tail.wait(seen, std::memory_order_acquire);
+    }
+}
+
+template<typename T, size_t Capacity>
+void SpscRing<T, Capacity>::push(const T& val) {
+    wait_for_space();
+    try_emplace(val);
+}
+
+template<typename T, size_t Capacity>
+void SpscRing<T, Capacity>::push(T&& val) {
+    wait_for_space();
+    try_emplace(std::move(val));
+}
+
+template<typename T, size_t Capacity>
+void SpscRing<T, Capacity>::pop(T& out) {
+    wait_for_data();
+    try_pop(out);
+}
+
+}
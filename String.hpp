@@ -2,264 +2,308 @@
 #include <cstring>
 #include <limits>
 #include <memory>
+#include <ostream>
+#include <charconv>
+#include <type_traits>
+#include "StringView.hpp"
+#include "Utf8.hpp"
 
 namespace gdamn::data {
 
+class StringBuilder;
+
+/*
+ * Byte string with small-string optimization: up to local_capacity characters live inside the object,
+ * longer ones go to the heap with n bytes of extra reserve. The length is always tracked, the buffer stays
+ * NUL-terminated for c_str().
+ */
 template<size_t n = 16>
 class BasicString {
+private:
+    struct Heap {
+        char*   ptr;
+        size_t  size;
+        size_t  capacity;   /* Characters that fit without the terminator */
+    };
+
+    static constexpr size_t local_size = sizeof(Heap) + sizeof(void*) - 1;
+    static constexpr unsigned char heap_tag = 0xFF;
+
 public:
+    static constexpr size_t local_capacity = local_size - 1; /* Leaves room for the terminator */
+
     /* Big 5 */
     BasicString();
     BasicString(const char*);
+    BasicString(const char*, size_t);
+    explicit BasicString(StringView str) : BasicString(str.data(), str.len()) {}
     BasicString(const BasicString&);
     BasicString(BasicString&&);
     ~BasicString();
 
     BasicString& operator=(const BasicString& other) {
-        if(buffer != nullptr) std::memset(buffer, 0, sizeof(buffer));
-
-        if(other.n_chars <= (n_chars + n_reserve) && this->buffer != nullptr) { // Enough space left for the required cBasicString    
-            std::strcpy(buffer, other.buffer);
-            this->n_reserve -= other.n_chars;
-        } else {
-            delete[] buffer;
-            this->buffer    = new char[other.n_chars + other.n_reserve];
-            this->n_chars   = other.n_chars;
-            this->n_reserve = other.n_reserve;
-            std::strcpy(buffer, other.buffer);
-        }
-
+        if(this != &other) assign(other.data(), other.len());
         return *this;
     }
 
     BasicString& operator=(BasicString&& other) {
-        delete[] buffer;
-        this->n_chars = other.n_chars;
-        this->n_reserve = other.n_reserve;
-        this->buffer = other.buffer;
-        other.buffer = nullptr;
-        other.n_chars = 0;
-        other.n_reserve = 0;
+        if(this == &other) return *this;
+        release();
+        std::memcpy((void*)this, (const void*)&other, sizeof(BasicString)); /* Both modes are plain bytes */
+        other.set_local(0);
         return *this;
     }
 
     BasicString& operator=(const char* str)  {
-        if(buffer != nullptr) std::memset(buffer, 0, sizeof(buffer));
-        size_t str_n = strlen(str);
-
-        if(str_n <= (n_chars + n_reserve)) {
-            strcpy(buffer, str);
-            n_reserve = (n_chars + n_reserve) - str_n;
-            n_chars = str_n;
-        } else {
-            delete[] buffer;
-            buffer = new char[str_n + n];
-            strcpy(buffer, str);
-            n_chars = str_n;
-            n_reserve = n;
-        }
-
+        assign(str, std::strlen(str));
         return *this;
     }
 
     void reserve(size_t num);
 
-    bool contains(const char character) const {
-        return strchr(buffer, (char)character) != nullptr;
-    }
-
-    bool contains(const char* str) const {
-        return strstr(buffer, str) != nullptr;
-    }
-
-    bool contains(const BasicString& str) const {
-        return this->contains(str.c_str());
-    }
-
-    bool contains(const BasicString&& str) const {
-        return this->contains(str.c_str());
-    }
-
-    size_t find(char character) {
-        char* where = strchr(buffer, (char)character); 
-        return where == nullptr ? (size_t)(where - buffer) : std::numeric_limits<size_t>::max();    
-    }
-
-    size_t find(const char* str) {
-        char* where = strstr(buffer, str); 
-        return where == nullptr ? (size_t)(where - buffer) : std::numeric_limits<size_t>::max();
-    }
-
-    size_t find(BasicString& str) {
-        return this->find(str.buffer);
-    }
-
-    size_t find(BasicString&& str) {
-        return this->find(str.buffer);
-    }
-
+    /* Searches work on the stored length, a needle given as const char* is measured once */
+    bool contains(const char character) const   { return view().find(character) != StringView::npos; }
+    bool contains(StringView str) const         { return view().find(str) != StringView::npos; }
+    bool contains(const char* str) const        { return contains(StringView(str)); }
+    bool contains(const BasicString& str) const { return contains(str.view()); }
+
+    size_t find(char character, size_t pos = 0) const           { return view().find(character, pos); }
+    size_t find(StringView str, size_t pos = 0) const           { return view().find(str, pos); }
+    size_t find(const char* str, size_t pos = 0) const          { return find(StringView(str), pos); }
+    size_t find(const BasicString& str, size_t pos = 0) const   { return find(str.view(), pos); }
+    size_t rfind(char character) const                          { return view().rfind(character); }
+    size_t rfind(StringView str) const                          { return view().rfind(str); }
+    size_t find_first_of(StringView set, size_t pos = 0) const  { return view().find_first_of(set, pos); }
+    size_t count(char character) const                          { return view().count(character); }
+    size_t count(StringView str) const                          { return view().count(str); }
+
+    /* Copy of everything from the first occurrence of str on, empty when it doesn't occur. substr() doesn't copy */
     BasicString from(BasicString&);
     BasicString from(BasicString&&);
     BasicString from(const char*);
 
-    char& operator[](size_t i) { return buffer[i]; }
-    
-    bool operator==(const BasicString& other) const {
-        return strcmp(buffer, other.buffer) == 0;
-    }
-
-    bool operator==(const char* other) const {
-        return strcmp(buffer, other) == 0;
-    }
+    StringView substr(size_t pos, size_t count = StringView::npos) const { return view().substr(pos, count); }
+    bool starts_with(StringView str) const  { return view().starts_with(str); }
+    bool ends_with(StringView str) const    { return view().ends_with(str); }
+    int compare(StringView str) const       { return view().compare(str); }
+
+    char& operator[](size_t i) { return data()[i]; }
+
+    /* Lengths are compared first, so unequal sizes never touch the characters */
+    bool operator==(const BasicString& other) const { return view() == other.view(); }
+    bool operator==(StringView other) const         { return view() == other; }
+    bool operator==(const char* other) const        { return view() == StringView(other); }
+    bool operator!=(const BasicString& other) const { return !(*this == other); }
+    bool operator!=(StringView other) const         { return !(*this == other); }
+    bool operator!=(const char* other) const        { return !(*this == other); }
+
+    bool operator<(const BasicString& other) const  { return compare(other.view()) < 0; }
+    bool operator<(const char* other) const         { return compare(StringView(other)) < 0; }
+    bool operator>(const BasicString& other) const  { return compare(other.view()) > 0; }
+    bool operator>(const char* other) const         { return compare(StringView(other)) > 0; }
+    bool operator<=(const BasicString& other) const { return compare(other.view()) <= 0; }
+    bool operator<=(const char* other) const        { return compare(StringView(other)) <= 0; }
+    bool operator>=(const BasicString& other) const { return compare(other.view()) >= 0; }
+    bool operator>=(const char* other) const        { return compare(StringView(other)) >= 0; }
 
-    bool operator!=(const BasicString& other) const {
-        return !(*this == other);
-    }
-
-    bool operator!=(const char* other) const {
-        return !(*this == other);
+    void operator+=(const BasicString& str) {
+        append(str.data(), str.len());
     }
 
-    bool operator<(const BasicString& other) const {
-        return strcmp(buffer, other.buffer) < 0;
+    void operator+=(const BasicString&& str) {
+        append(str.data(), str.len());
     }
 
-    bool operator<(const char* other) const {
-        return strcmp(buffer, other) < 0;
+    void operator+=(const char* str) {
+        append(str, std::strlen(str));
     }
 
-    bool operator>(const BasicString& other) const {
-        return !(*this < other);
+    void operator+=(StringView str) {
+        append(str.data(), str.len());
     }
 
-    bool operator>(const char* other) const {
-        return !(*this < other);
-    }
+    void append(const char* str, size_t count);
 
-    bool operator<=(const BasicString& other) const {
-        return strcmp(buffer, other.buffer) <= 0;
+    /* Shortest round-trip text for value (to_chars), written without going through std::string */
+    template<typename N> requires (std::is_arithmetic_v<N> && !std::is_same_v<N, char> && !std::is_same_v<N, bool>)
+    void append(N value) {
+        char digits[64];
+        std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+        append(digits, (size_t)(result.ptr - digits));
     }
 
-    bool operator<=(const char* other) const {
-        return strcmp(buffer, other) <= 0;
-    }
+    template<typename T>
+    bool try_parse(T& out) const    { return view().template try_parse<T>(out); }
+    template<typename T>
+    T parse() const                 { return view().template parse<T>(); }
+
+    char* data()                    { return is_local() ? local : heap.ptr; }
+    const char* data() const        { return is_local() ? local : heap.ptr; }
+    const char* c_str() const       { return data(); }
+    size_t len() const              { return is_local() ? tag() : heap.size; }
+    size_t capacity() const         { return is_local() ? local_capacity : heap.capacity; }
+    size_t available_reserve() const { return capacity() - len(); }
+    bool is_local() const           { return tag() != heap_tag; }
+
+    StringView view() const         { return StringView(data(), len()); }
+
+    /* Fields point into this string, which has to outlive the range (don't split a temporary) */
+    SplitRange split(char delimiter) const      { return view().split(delimiter); }
+    SplitRange split(StringView delimiter) const { return view().split(delimiter); }
+    SplitRange split_any(StringView set) const  { return view().split_any(set); }
+    SplitRange lines() const                    { return view().lines(); }
+
+    /* Text helpers, the string itself stays a byte sequence */
+    bool is_valid_utf8() const                  { return utf8::is_valid(view()); }
+    size_t utf8_length() const                  { return utf8::length(view()); } /* Assumes valid UTF-8 */
+    utf8::CodePoints code_points() const        { return utf8::code_points(view()); }
+    operator StringView() const     { return view(); }
 
-    bool operator>=(const BasicString& other) const {
-        return !(*this >= other);
-    }
+    template<size_t m>
+    friend std::ostream& operator<< (std::ostream& os, const BasicString<m>& p_t);
 
-    bool operator>=(const char* other) const {
-        return !(*this <= other);
+private:
+    void assign(const char* str, size_t count);
+    void grow(size_t new_capacity);
+    void release() { if(!is_local()) delete[] heap.ptr; }
+
+    /* Takes ownership of a new[]'d, NUL-terminated buffer of capacity + 1 bytes */
+    void adopt(char* buffer, size_t size, size_t capacity) {
+        heap.ptr = buffer;
+        heap.size = size;
+        heap.capacity = capacity;
+        tag() = heap_tag;
     }
 
-    void operator+=(const BasicString& str) {
-        (*this) += str.buffer;
-    }
+    friend class StringBuilder;
 
-    void operator+=(const BasicString&& str) {
-        (*this) += str.buffer;
+    void set_local(size_t size) {
+        tag() = (unsigned char)size;
+        local[size] = '\0';
     }
 
-    void operator+=(const char* str) {
-        size_t n_str = strlen(str);
-
-        if(n_str <= n_reserve) {
-            strcpy(buffer + n_chars, str);
-        } else {
-            char* temp = new char[n_chars + n_str + n]; // Provide new reserves
-            std::memset(temp, 0, sizeof(temp));
-            strcpy(temp, buffer);
-            strcpy(temp + n_chars, str);
-            delete[] buffer;
-            buffer = temp;
-        }
+    void set_len(size_t size) {
+        if(is_local())  set_local(size);
+        else            { heap.size = size; heap.ptr[size] = '\0'; }
     }
-    
-    const char* c_str() const { return buffer; }
-    size_t len() const { return n_chars; }
-    size_t available_reserve() const { return n_reserve; }
 
-    template<size_t m>
-    friend std::ostream& operator<< (std::ostream& os, const BasicString<m>& p_t);
+    /* The last byte holds the length while the string is local and heap_tag once it lives on the heap */
+    unsigned char& tag()        { return reinterpret_cast<unsigned char&>(local[local_size]); }
+    unsigned char tag() const   { return (unsigned char)local[local_size]; }
 
-private:
-    char* buffer = nullptr;
-    size_t n_chars = 0;
-    size_t n_reserve = 0;
+    union {
+        Heap heap;
+        char local[local_size + 1];
+    };
 };
 
 template<size_t n>
 std::ostream& operator<<(std::ostream& os, const BasicString<n>& str) {
-    os << str.c_str();
+    os.write(str.data(), str.len());
     return os;
 }
 
 template<size_t n>
 BasicString<n>::BasicString() {
-    buffer = new char[n];
-    std::memset(buffer, 0, sizeof(buffer));
-    n_reserve = n;
+    set_local(0);
 }
 
 template<size_t n>
 BasicString<n>::BasicString(const char* str) {
-    if(str != nullptr) {
-        buffer = new char[std::strlen(str) + n];
-        std::strcpy(buffer, str);
-        n_chars = std::strlen(str);
-        n_reserve = n;
-    } else {
-        buffer = new char[n];
-        std::memset(buffer, 0, sizeof(buffer));
-        n_reserve = n;
-    }
+    set_local(0);
+    if(str != nullptr) assign(str, std::strlen(str));
+}
+
+template<size_t n>
+BasicString<n>::BasicString(const char* str, size_t count) {
+    set_local(0);
+    assign(str, count);
 }
 
 template<size_t n>
 BasicString<n>::BasicString(const BasicString& other) {
-    this->n_chars = other.n_chars;
-    this->n_reserve = other.n_reserve;
-    buffer = new char[n_chars + n_reserve];
-    std::strcpy(buffer, other.c_str());
+    if(other.is_local()) { /* Copying the whole object is cheaper than working out the length */
+        std::memcpy((void*)this, (const void*)&other, sizeof(BasicString));
+        return;
+    }
+    set_local(0);
+    assign(other.data(), other.len());
 }
 
 template<size_t n>
 BasicString<n>::BasicString(BasicString&& other) {
-    delete[] buffer;
-    this->buffer = other.buffer;
-    this->n_chars = other.n_chars;
-    this->n_reserve = other.n_reserve;
-    other.buffer = nullptr;
+    std::memcpy((void*)this, (const void*)&other, sizeof(BasicString));
+    other.set_local(0);
 }
 
 template<size_t n>
 BasicString<n>::~BasicString() {
-    if(buffer != nullptr) std::memset(buffer, 0, sizeof(buffer));
-    delete[] buffer;
+    release();
+}
+
+/* Moves the contents into a heap buffer able to hold new_capacity characters */
+template<size_t n>
+void BasicString<n>::grow(size_t new_capacity) {
+    size_t size = len();
+    char* temp = new char[new_capacity + 1];
+    std::memcpy(temp, data(), size);
+    temp[size] = '\0';
+
+    release();
+    adopt(temp, size, new_capacity);
+}
+
+template<size_t n>
+void BasicString<n>::assign(const char* str, size_t count) {
+    if(count > capacity()) {
+        release();
+        set_local(0);
+        grow(count + n);
+    }
+    std::memmove(data(), str, count);
+    set_len(count);
+}
+
+template<size_t n>
+void BasicString<n>::append(const char* str, size_t count) {
+    size_t size = len();
+    if(size + count > capacity()) {
+        /* Geometric growth keeps repeated appends amortized O(1), n stays the minimum extra reserve */
+        size_t new_capacity = size + count + n;
+        if(new_capacity < capacity() * 2) new_capacity = capacity() * 2;
+
+        char* temp = new char[new_capacity + 1];
+        std::memcpy(temp, data(), size);
+        std::memcpy(temp + size, str, count); /* str may point into the old buffer, so copy before releasing it */
+        temp[size + count] = '\0';
+        release();
+        adopt(temp, size + count, new_capacity);
+        return;
+    }
+    std::memcpy(data() + size, str, count);
+    set_len(size + count);
 }
 
 template<size_t n>
 BasicString<n> BasicString<n>::from(BasicString& str) {
-    return std::move(BasicString<n>(strstr(buffer, str.buffer)));
+    size_t where = view().find(str.view());
+    return where != StringView::npos ? BasicString<n>(substr(where)) : BasicString<n>();
 }
 
 template<size_t n>
 BasicString<n> BasicString<n>::from(BasicString<n>&& str) {
-    return std::move(BasicString<n>(strstr(buffer, str.buffer)));
+    return from(str);
 }
 
 template<size_t n>
 BasicString<n> BasicString<n>::from(const char* str) {
-    return std::move(BasicString<n>(strstr(buffer, str)));
+    size_t where = view().find(StringView(str));
+    return where != StringView::npos ? BasicString<n>(substr(where)) : BasicString<n>();
 }
 
 template<size_t n>
 void BasicString<n>::reserve(size_t num) {
-    char* temp = new char[n_chars + n_reserve + num];
-    strcpy(temp, buffer);
-    delete[] buffer;
-    buffer = temp;
-    n_reserve += num;
+    grow(capacity() + num);
 }
 
 template<typename T, typename U, size_t bucket_count>
@@ -274,11 +318,20 @@ using String = BasicString<16>;
 namespace std {
     template <size_t n>
     struct hash<gdamn::data::BasicString<n>> {
-        size_t operator()(const gdamn::data::BasicString<n>& str) {
-            size_t hash = 0;
-            for(size_t i = 0; i < str.len(); i++)
-                hash += str.c_str()[i];
-            return hash;
+        /* Lets HashTable look BasicString keys up by StringView without building a string */
+        using is_transparent = void;
+
+        size_t operator()(const gdamn::data::BasicString<n>& str) const {
+            return gdamn::data::hash_bytes(str.data(), str.len());
+        }
+
+        size_t operator()(gdamn::data::StringView str) const {
+            return gdamn::data::hash_bytes(str.data(), str.len());
+        }
+
+        /* Literals convert to both overloads above, this one keeps them from picking a temporary string */
+        size_t operator()(const char* str) const {
+            return gdamn::data::hash_bytes(str, std::strlen(str));
         }
     };
-}
\ No newline at end of file
+}
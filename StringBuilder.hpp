@@ -0,0 +1,165 @@
+#pragma once
+#include <cstdio>
+#include <cstdarg>
+#include <charconv>
+#include <cstring>
+#include <utility>
+#include <type_traits>
+#include "String.hpp"
+
+namespace gdamn::data {
+
+/*
+ * Accumulates fragments into one buffer that doubles when it runs out, so building a string from k pieces
+ * costs O(total length) instead of a reallocation per piece. finish() hands the buffer to a BasicString as is.
+ */
+class StringBuilder {
+public:
+    explicit StringBuilder(size_t capacity = 0) { if(capacity != 0) grow(capacity); }
+    ~StringBuilder() { delete[] buffer; }
+
+    StringBuilder(const StringBuilder&) = delete;
+    StringBuilder& operator=(const StringBuilder&) = delete;
+
+    StringBuilder(StringBuilder&& other) :
+        buffer(std::exchange(other.buffer, nullptr)), size(std::exchange(other.size, 0)), cap(std::exchange(other.cap, 0)) {}
+
+    StringBuilder& operator=(StringBuilder&& other) {
+        if(this == &other) return *this;
+        delete[] buffer;
+        buffer = std::exchange(other.buffer, nullptr);
+        size = std::exchange(other.size, 0);
+        cap = std::exchange(other.cap, 0);
+        return *this;
+    }
+
+    StringBuilder& append(const char* str, size_t count);
+    StringBuilder& append(StringView str)       { return append(str.data(), str.len()); }
+    StringBuilder& append(char character, size_t repeat = 1);
+
+    /* Formats value with to_chars straight into the buffer */
+    template<typename N> requires (std::is_arithmetic_v<N> && !std::is_same_v<N, char> && !std::is_same_v<N, bool>)
+    StringBuilder& append(N value);
+
+    /* Appends every part after a single capacity check, for gluing a known set of fragments */
+    template<typename... Parts>
+    StringBuilder& append_all(const Parts&... parts);
+
+    /* printf-style, formatted straight into the free space and only retried when it doesn't fit */
+    StringBuilder& append_format(const char* format, ...);
+
+    template<typename S> requires std::is_convertible_v<const S&, StringView>
+    StringBuilder& operator<<(const S& str)     { return append(StringView(str)); }
+    StringBuilder& operator<<(char character)   { return append(character); }
+    template<typename N> requires (std::is_arithmetic_v<N> && !std::is_same_v<N, char> && !std::is_same_v<N, bool>)
+    StringBuilder& operator<<(N value)          { return append(value); }
+
+    void reserve(size_t count)  { if(size + count > cap) grow(size + count); }
+    void clear()                { size = 0; }
+
+    size_t len() const          { return size; }
+    size_t capacity() const     { return cap; }
+    bool empty() const          { return size == 0; }
+    StringView view() const     { return StringView(buffer, size); }
+
+    /* Moves the contents into a BasicString without copying and leaves the builder empty */
+    template<size_t n = 16>
+    BasicString<n> finish();
+
+private:
+    void grow(size_t min_capacity);
+
+    char*   buffer = nullptr;   /* cap + 1 bytes, the extra one for the terminator finish() writes */
+    size_t  size = 0;
+    size_t  cap = 0;
+};
+
+inline void StringBuilder::grow(size_t min_capacity) {
+    size_t new_capacity = cap < 32 ? 32 : cap * 2;
+    if(new_capacity < min_capacity) new_capacity = min_capacity;
+
+    char* temp = new char[new_capacity + 1];
+    if(size != 0) std::memcpy(temp, buffer, size);
+    delete[] buffer;
+    buffer = temp;
+    cap = new_capacity;
+}
+
+inline StringBuilder& StringBuilder::append(const char* str, size_t count) {
+    if(size + count > cap) {
+        if(buffer != nullptr && str >= buffer && str < buffer + size) { /* A piece of ourselves, keep it valid across grow */
+            size_t offset = (size_t)(str - buffer);
+            grow(size + count);
+            str = buffer + offset;
+        } else {
+            grow(size + count);
+        }
+    }
+    if(count != 0) std::memcpy(buffer + size, str, count);
+    size += count;
+    return *this;
+}
+
+inline StringBuilder& StringBuilder::append(char character, size_t repeat) {
+    reserve(repeat);
+    if(repeat != 0) std::memset(buffer + size, character, repeat);
+    size += repeat;
+    return *this;
+}
+
+template<typename N> requires (std::is_arithmetic_v<N> && !std::is_same_v<N, char> && !std::is_same_v<N, bool>)
+StringBuilder& StringBuilder::append(N value) {
+    reserve(64); /* Enough for any integer and the longest shortest-form double */
+    std::to_chars_result result = std::to_chars(buffer + size, buffer + cap, value);
+    size = (size_t)(result.ptr - buffer);
+    return *this;
+}
+
+template<typename... Parts>
+StringBuilder& StringBuilder::append_all(const Parts&... parts) {
+    const StringView views[] = { StringView(parts)... };
+    size_t total = 0;
+    for(const StringView& part : views) total += part.len();
+    reserve(total);
+    for(const StringView& part : views) append(part);
+    return *this;
+}
+
+inline StringBuilder& StringBuilder::append_format(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    va_list retry;
+    va_copy(retry, args);
+
+    size_t available = cap - size;
+    int written = std::vsnprintf(buffer != nullptr ? buffer + size : nullptr, buffer != nullptr ? available + 1 : 0, format, args);
+    va_end(args);
+
+    if(written > 0 && (size_t)written > available) {
+        reserve((size_t)written);
+        std::vsnprintf(buffer + size, (size_t)written + 1, format, retry);
+    }
+    va_end(retry);
+
+    if(written > 0) size += (size_t)written;
+    return *this;
+}
+
+template<size_t n>
+BasicString<n> StringBuilder::finish() {
+    BasicString<n> str;
+    if(size <= BasicString<n>::local_capacity) { /* Short results fit inline, the builder keeps its buffer for reuse */
+        if(size != 0) str.append(buffer, size);
+        size = 0;
+        return str;
+    }
+
+    buffer[size] = '\0';
+    str.adopt(buffer, size, cap);
+    buffer = nullptr;
+    size = 0;
+    cap = 0;
+    return str;
+}
+
+}
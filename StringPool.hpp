@@ -0,0 +1,200 @@
+#pragma once
+#include <cstring>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include "StringView.hpp"
+
+namespace gdamn::data {
+
+template<typename T, typename U, size_t bucket_count>
+class HashTable;
+template<size_t n>
+class BasicString;
+
+class StringPool;
+
+/*
+ * Handle to a string interned in a StringPool. Equal contents in the same pool give the same Atom, so equality
+ * is one pointer compare and the hash was computed once at interning. Valid as long as its pool lives.
+ */
+class Atom {
+public:
+    Atom() {}
+
+    StringView view() const     { return entry != nullptr ? StringView(entry->chars(), entry->size) : StringView(); }
+    const char* c_str() const   { return entry != nullptr ? entry->chars() : ""; }
+    size_t len() const          { return entry != nullptr ? entry->size : 0; }
+    size_t hash() const         { return entry != nullptr ? entry->hash : 0; }
+    bool empty() const          { return len() == 0; }
+    explicit operator bool() const { return entry != nullptr; }
+    operator StringView() const { return view(); }
+
+    bool operator==(const Atom& other) const { return entry == other.entry; }
+    bool operator!=(const Atom& other) const { return entry != other.entry; }
+
+    friend std::ostream& operator<<(std::ostream& os, const Atom& atom) {
+        return os << atom.view();
+    }
+
+private:
+    struct Entry {
+        size_t hash;
+        size_t size;
+        /* size characters and a terminator follow the header */
+        const char* chars() const { return reinterpret_cast<const char*>(this + 1); }
+    };
+
+    explicit Atom(const Entry* entry) : entry(entry) {}
+
+    const Entry* entry = nullptr;
+    friend StringPool;
+};
+
+/*
+ * Interns strings into an arena of fixed-size blocks and hands out Atoms. Lookup goes through an open-addressed
+ * table of entry pointers keyed by the string hash; entries are never freed individually, only with the pool.
+ * Not synchronized: share one pool per thread or guard it externally.
+ */
+class StringPool {
+private:
+    using Entry = Atom::Entry;
+
+    struct Block {
+        Block*  next;
+        size_t  capacity;
+        size_t  used;
+        char*   storage() { return reinterpret_cast<char*>(this + 1); }
+    };
+
+public:
+    explicit StringPool(size_t block_bytes = 64 * 1024) : block_bytes(block_bytes) {}
+    ~StringPool();
+
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+
+    /* Returns the Atom for str, copying it into the arena the first time it is seen */
+    Atom intern(StringView str);
+    /* Returns the Atom for str if it was interned before, a null Atom otherwise. Never allocates */
+    Atom find(StringView str) const;
+    bool contains(StringView str) const { return static_cast<bool>(find(str)); }
+
+    size_t len() const          { return n_entries; }
+    size_t bytes_used() const   { return arena_bytes; }
+
+private:
+    size_t probe(StringView str, size_t hash) const;
+    void grow_table();
+    Entry* allocate(size_t bytes);
+
+    const Entry**   table = nullptr;    /* Power-of-two slots, nullptr when free */
+    size_t          table_mask = 0;
+    size_t          n_entries = 0;
+    Block*          blocks = nullptr;   /* Newest first, allocation bumps the head block */
+    size_t          block_bytes = 0;
+    size_t          arena_bytes = 0;
+};
+
+inline StringPool::~StringPool() {
+    delete[] table;
+    while(blocks != nullptr) {
+        Block* del = blocks;
+        blocks = blocks->next;
+        ::operator delete(del);
+    }
+}
+
+/* Slot holding str, or the free slot where it belongs */
+inline size_t StringPool::probe(StringView str, size_t hash) const {
+    for(size_t i = hash & table_mask;; i = (i + 1) & table_mask) {
+        const Entry* entry = table[i];
+        if(entry == nullptr) return i;
+        if(entry->hash == hash && StringView(entry->chars(), entry->size) == str) return i;
+    }
+}
+
+inline void StringPool::grow_table() {
+    size_t new_size = table == nullptr ? 64 : (table_mask + 1) * 2;
+    const Entry** old_table = table;
+    size_t old_size = table == nullptr ? 0 : table_mask + 1;
+
+    table = new const Entry*[new_size]();
+    table_mask = new_size - 1;
+    for(size_t i = 0; i < old_size; i++) {
+        if(old_table[i] == nullptr) continue;
+        size_t slot = old_table[i]->hash & table_mask;
+        while(table[slot] != nullptr) slot = (slot + 1) & table_mask;
+        table[slot] = old_table[i];
+    }
+    delete[] old_table;
+}
+
+inline StringPool::Entry* StringPool::allocate(size_t bytes) {
+    bytes = (bytes + alignof(Entry) - 1) & ~(alignof(Entry) - 1);
+    if(blocks == nullptr || blocks->capacity - blocks->used < bytes) {
+        size_t capacity = bytes > block_bytes ? bytes : block_bytes;
+        Block* block = static_cast<Block*>(::operator new(sizeof(Block) + capacity));
+        block->capacity = capacity;
+        block->used = 0;
+
+        if(blocks != nullptr && bytes > block_bytes) { /* Oversized string, keep bumping the current block */
+            block->next = blocks->next;
+            blocks->next = block;
+        } else {
+            block->next = blocks;
+            blocks = block;
+        }
+        arena_bytes += capacity;
+        block->used = bytes;
+        return reinterpret_cast<Entry*>(block->storage());
+    }
+
+    Entry* entry = reinterpret_cast<Entry*>(blocks->storage() + blocks->used);
+    blocks->used += bytes;
+    return entry;
+}
+
+inline Atom StringPool::find(StringView str) const {
+    if(table == nullptr) return Atom();
+    return Atom(table[probe(str, hash_bytes(str.data(), str.len()))]);
+}
+
+inline Atom StringPool::intern(StringView str) {
+    if(table == nullptr) grow_table();
+
+    size_t hash = hash_bytes(str.data(), str.len());
+    size_t slot = probe(str, hash);
+    if(table[slot] != nullptr) return Atom(table[slot]);
+
+    /* Only an actual insert grows, so interning a string the pool already has never rehashes */
+    if((n_entries + 1) * 4 > (table_mask + 1) * 3) { /* Load factor <= 0.75 */
+        grow_table();
+        slot = probe(str, hash);
+    }
+
+    Entry* entry = allocate(sizeof(Entry) + str.len() + 1);
+    entry->hash = hash;
+    entry->size = str.len();
+    char* chars = const_cast<char*>(entry->chars());
+    if(str.len() != 0) std::memcpy(chars, str.data(), str.len());
+    chars[str.len()] = '\0';
+
+    table[slot] = entry;
+    n_entries++;
+    return Atom(entry);
+}
+
+/* Dictionary keyed by interned strings: hashing reads the stored hash, key equality is a pointer compare */
+using AtomDictionary = HashTable<Atom, BasicString<16>, 256>;
+
+}
+
+namespace std {
+    template <>
+    struct hash<gdamn::data::Atom> {
+        size_t operator()(const gdamn::data::Atom& atom) const {
+            return atom.hash();
+        }
+    };
+}
@@ -0,0 +1,189 @@
+#pragma once
+#include <bit>
+#include <cstring>
+#include <cstdint>
+#include <limits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/*
+ * Length-based search kernels behind StringView and BasicString. Nothing reads past data + count or looks for a terminator.
+ * The vector paths are picked at compile time: AVX2 when the target has it (-mavx2 / -march=native), SSE2 on any x86-64,
+ * plain scalar code elsewhere. Every function returns an index or npos.
+ */
+namespace gdamn::data::search {
+
+inline constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+inline size_t find_char(const char* data, size_t count, char character) {
+    const void* where = count != 0 ? std::memchr(data, character, count) : nullptr;
+    return where != nullptr ? (size_t)((const char*)where - data) : npos;
+}
+
+inline size_t rfind_char(const char* data, size_t count, char character) {
+    size_t i = count;
+#if defined(__AVX2__)
+    const __m256i target32 = _mm256_set1_epi8(character);
+    for(; i >= 32; i -= 32) {
+        __m256i block = _mm256_loadu_si256((const __m256i*)(data + i - 32));
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, target32));
+        if(mask != 0) return i - 32 + (31 - std::countl_zero(mask));
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128i target16 = _mm_set1_epi8(character);
+    for(; i >= 16; i -= 16) {
+        __m128i block = _mm_loadu_si128((const __m128i*)(data + i - 16));
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block, target16));
+        if(mask != 0) return i - 16 + (31 - std::countl_zero(mask));
+    }
+#endif
+    while(i-- > 0)
+        if(data[i] == character) return i;
+    return npos;
+}
+
+inline size_t count_char(const char* data, size_t count, char character) {
+    size_t total = 0;
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i target32 = _mm256_set1_epi8(character);
+    for(; i + 32 <= count; i += 32) {
+        __m256i block = _mm256_loadu_si256((const __m256i*)(data + i));
+        total += std::popcount((uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, target32)));
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128i target16 = _mm_set1_epi8(character);
+    for(; i + 16 <= count; i += 16) {
+        __m128i block = _mm_loadu_si128((const __m128i*)(data + i));
+        total += std::popcount((uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block, target16)));
+    }
+#endif
+    for(; i < count; i++) total += data[i] == character;
+    return total;
+}
+
+/*
+ * Substring search comparing the first and last needle character against a whole block at once (Muła's
+ * "SIMD-friendly" algorithm); only positions where both match get a memcmp of the middle.
+ */
+inline size_t find(const char* data, size_t count, const char* needle, size_t needle_len) {
+    if(needle_len == 0) return 0;
+    if(needle_len > count) return npos;
+    if(needle_len == 1) return find_char(data, count, needle[0]);
+
+    const size_t tail = needle_len - 1;
+    const char first = needle[0];
+    const char last = needle[tail];
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    const __m256i first32 = _mm256_set1_epi8(first);
+    const __m256i last32 = _mm256_set1_epi8(last);
+    for(; i + tail + 32 <= count; i += 32) {
+        __m256i block_first = _mm256_loadu_si256((const __m256i*)(data + i));
+        __m256i block_last = _mm256_loadu_si256((const __m256i*)(data + i + tail));
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(block_first, first32), _mm256_cmpeq_epi8(block_last, last32)));
+        for(; mask != 0; mask &= mask - 1) {
+            size_t at = i + std::countr_zero(mask);
+            if(std::memcmp(data + at + 1, needle + 1, tail - 1) == 0) return at;
+        }
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128i first16 = _mm_set1_epi8(first);
+    const __m128i last16 = _mm_set1_epi8(last);
+    for(; i + tail + 16 <= count; i += 16) {
+        __m128i block_first = _mm_loadu_si128((const __m128i*)(data + i));
+        __m128i block_last = _mm_loadu_si128((const __m128i*)(data + i + tail));
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(block_first, first16), _mm_cmpeq_epi8(block_last, last16)));
+        for(; mask != 0; mask &= mask - 1) {
+            size_t at = i + std::countr_zero(mask);
+            if(std::memcmp(data + at + 1, needle + 1, tail - 1) == 0) return at;
+        }
+    }
+#endif
+
+    for(; i + tail < count; i++)
+        if(data[i] == first && data[i + tail] == last && std::memcmp(data + i + 1, needle + 1, tail - 1) == 0)
+            return i;
+    return npos;
+}
+
+inline size_t rfind(const char* data, size_t count, const char* needle, size_t needle_len) {
+    if(needle_len > count) return npos;
+    if(needle_len == 0) return count;
+    if(needle_len == 1) return rfind_char(data, count, needle[0]);
+
+    for(size_t i = count - needle_len + 1; i-- > 0;)
+        if(data[i] == needle[0] && std::memcmp(data + i + 1, needle + 1, needle_len - 1) == 0) return i;
+    return npos;
+}
+
+/* Non-overlapping occurrences, an empty needle counts as none */
+inline size_t count(const char* data, size_t size, const char* needle, size_t needle_len) {
+    if(needle_len == 0) return 0;
+    if(needle_len == 1) return count_char(data, size, needle[0]);
+
+    size_t total = 0;
+    for(size_t i = 0;; total++) {
+        size_t at = find(data + i, size - i, needle, needle_len);
+        if(at == npos) return total;
+        i += at + needle_len;
+    }
+}
+
+/*
+ * Sets of up to 8 characters (the usual delimiter sets) compare each block against every member;
+ * larger sets use a 256-bit membership table with one lookup per character.
+ */
+inline size_t find_first_of(const char* data, size_t count, const char* set, size_t set_len) {
+    if(set_len == 0) return npos;
+    if(set_len == 1) return find_char(data, count, set[0]);
+
+    size_t i = 0;
+    if(set_len <= 8) {
+#if defined(__AVX2__)
+        __m256i members32[8];
+        for(size_t k = 0; k < set_len; k++) members32[k] = _mm256_set1_epi8(set[k]);
+        for(; i + 32 <= count; i += 32) {
+            __m256i block = _mm256_loadu_si256((const __m256i*)(data + i));
+            __m256i hits = _mm256_cmpeq_epi8(block, members32[0]);
+            for(size_t k = 1; k < set_len; k++) hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(block, members32[k]));
+            uint32_t mask = (uint32_t)_mm256_movemask_epi8(hits);
+            if(mask != 0) return i + std::countr_zero(mask);
+        }
+#endif
+#if defined(__SSE2__)
+        __m128i members16[8];
+        for(size_t k = 0; k < set_len; k++) members16[k] = _mm_set1_epi8(set[k]);
+        for(; i + 16 <= count; i += 16) {
+            __m128i block = _mm_loadu_si128((const __m128i*)(data + i));
+            __m128i hits = _mm_cmpeq_epi8(block, members16[0]);
+            for(size_t k = 1; k < set_len; k++) hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, members16[k]));
+            uint32_t mask = (uint32_t)_mm_movemask_epi8(hits);
+            if(mask != 0) return i + std::countr_zero(mask);
+        }
+#endif
+    }
+
+    uint64_t table[4] = {};
+    for(size_t k = 0; k < set_len; k++) {
+        unsigned char c = (unsigned char)set[k];
+        table[c >> 6] |= 1ull << (c & 63);
+    }
+    for(; i < count; i++) {
+        unsigned char c = (unsigned char)data[i];
+        if(table[c >> 6] & (1ull << (c & 63))) return i;
+    }
+    return npos;
+}
+
+}
@@ -0,0 +1,278 @@
+#pragma once
+#include <charconv>
+#include <cstring>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+#include "StringSearch.hpp"
+
+namespace gdamn::data {
+
+/* FNV-1a, shared by every string type so equal contents hash equally whatever holds them */
+inline size_t hash_bytes(const char* data, size_t count) {
+    uint64_t hash = 14695981039346656037ull;
+    for(size_t i = 0; i < count; i++) {
+        hash ^= (unsigned char)data[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+class SplitRange;
+
+/*
+ * Non-owning pointer + length over characters that live somewhere else (a BasicString, a literal, a buffer).
+ * Nothing here allocates or relies on a terminator; the viewed characters have to outlive the view.
+ */
+class StringView {
+public:
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    constexpr StringView() {}
+    constexpr StringView(const char* str, size_t count) : ptr(str), size(count) {}
+    StringView(const char* str) : ptr(str), size(str != nullptr ? std::strlen(str) : 0) {}
+
+    const char* data() const        { return ptr; }
+    size_t len() const              { return size; }
+    bool empty() const              { return size == 0; }
+    char operator[](size_t i) const { return ptr[i]; }
+    const char* begin() const       { return ptr; }
+    const char* end() const         { return ptr + size; }
+
+    /* Clamped like std::string_view, but never throws: pos past the end gives an empty view */
+    StringView substr(size_t pos, size_t count = npos) const {
+        if(pos > size) pos = size;
+        return StringView(ptr + pos, count < size - pos ? count : size - pos);
+    }
+
+    void remove_prefix(size_t count) { count = count < size ? count : size; ptr += count; size -= count; }
+    void remove_suffix(size_t count) { size -= count < size ? count : size; }
+
+    size_t find(char character, size_t pos = 0) const;
+    size_t find(StringView str, size_t pos = 0) const;
+    size_t rfind(char character) const  { return search::rfind_char(ptr, size, character); }
+    size_t rfind(StringView str) const  { return search::rfind(ptr, size, str.ptr, str.size); }
+    size_t find_first_of(StringView set, size_t pos = 0) const;
+    size_t count(char character) const { return search::count_char(ptr, size, character); }
+    size_t count(StringView str) const  { return search::count(ptr, size, str.ptr, str.size); } /* Non-overlapping */
+    bool contains(char character) const     { return find(character) != npos; }
+    bool contains(StringView str) const     { return find(str) != npos; }
+
+    bool starts_with(StringView str) const {
+        return str.size <= size && (str.size == 0 || std::memcmp(ptr, str.ptr, str.size) == 0);
+    }
+
+    bool ends_with(StringView str) const {
+        return str.size <= size && (str.size == 0 || std::memcmp(ptr + size - str.size, str.ptr, str.size) == 0);
+    }
+
+    /* <0, 0 or >0 like strcmp, a proper prefix orders first */
+    int compare(StringView other) const {
+        size_t common = size < other.size ? size : other.size;
+        int cmp = common != 0 ? std::memcmp(ptr, other.ptr, common) : 0;
+        if(cmp != 0) return cmp;
+        return size < other.size ? -1 : (size > other.size ? 1 : 0);
+    }
+
+    /*
+     * Lazy, allocation-free field ranges over this view; each field is a StringView into it.
+     * Consecutive delimiters give empty fields and a trailing delimiter gives a trailing empty field.
+     * lines() splits on '\n', drops a '\r' before it and doesn't report an empty last line.
+     */
+    SplitRange split(char delimiter) const;
+    SplitRange split(StringView delimiter) const;
+    SplitRange split_any(StringView set) const;
+    SplitRange lines() const;
+
+    /* The whole view has to be the number (from_chars grammar, no whitespace or leading '+'), nothing allocates */
+    template<typename T>
+    bool try_parse(T& out) const;
+    /* Same, but gives T{} when the view isn't a valid number */
+    template<typename T>
+    T parse() const { T value{}; return try_parse(value) ? value : T{}; }
+
+    bool operator==(StringView other) const {
+        return size == other.size && (size == 0 || std::memcmp(ptr, other.ptr, size) == 0);
+    }
+
+    bool operator!=(StringView other) const { return !(*this == other); }
+    bool operator<(StringView other) const  { return compare(other) < 0; }
+    bool operator>(StringView other) const  { return compare(other) > 0; }
+    bool operator<=(StringView other) const { return compare(other) <= 0; }
+    bool operator>=(StringView other) const { return compare(other) >= 0; }
+
+    friend std::ostream& operator<<(std::ostream& os, StringView str) {
+        os.write(str.ptr, str.size);
+        return os;
+    }
+
+private:
+    const char* ptr = nullptr;
+    size_t      size = 0;
+};
+
+/* Forward range of the fields produced by StringView::split / split_any / lines */
+class SplitRange {
+private:
+    enum class Mode { Character, Sequence, AnyOf, Lines };
+
+    struct Delimiter {
+        Mode        mode;
+        char        character = '\0';
+        StringView  sequence;   /* The delimiter for Sequence, the set for AnyOf */
+
+        /* Position of the next delimiter in text and its length, npos when there is none */
+        size_t find(StringView text, size_t& length) const {
+            switch(mode) {
+            case Mode::Character:
+            case Mode::Lines:
+                length = 1;
+                return search::find_char(text.data(), text.len(), character);
+            case Mode::AnyOf:
+                length = 1;
+                return search::find_first_of(text.data(), text.len(), sequence.data(), sequence.len());
+            case Mode::Sequence:
+                length = sequence.len();
+                return sequence.empty() ? StringView::npos : search::find(text.data(), text.len(), sequence.data(), sequence.len());
+            }
+            return StringView::npos;
+        }
+    };
+
+public:
+    /* Carries its own copy of the delimiter, so it stays valid as long as the split text does */
+    class Iterator {
+    public:
+        Iterator() {}
+
+        Iterator& operator++() {
+            advance();
+            return *this;
+        }
+
+        Iterator& operator++(int) {
+            advance();
+            return *this;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return done == other.done && (done || field.data() == other.field.data());
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return !(*this == other);
+        }
+
+        StringView operator*() const    { return field; }
+        const StringView* operator->() const { return &field; }
+
+    private:
+        Iterator(StringView text, Delimiter delimiter) : remaining(text), delimiter(delimiter), done(false) { advance(); }
+
+        void advance() {
+            if(last) { done = true; return; }
+
+            size_t length = 0;
+            size_t where = delimiter.find(remaining, length);
+            if(where == StringView::npos) {
+                field = remaining;
+                last = true;
+                if(delimiter.mode == Mode::Lines && field.empty()) { done = true; return; }
+            } else {
+                field = remaining.substr(0, where);
+                remaining.remove_prefix(where + length);
+            }
+            if(delimiter.mode == Mode::Lines && field.ends_with("\r")) field.remove_suffix(1);
+        }
+
+        StringView  remaining;
+        StringView  field;
+        Delimiter   delimiter = { Mode::Character, '\0', StringView() };
+        bool        last = false;   /* field is the final one */
+        bool        done = true;
+        friend SplitRange;
+    };
+
+    Iterator begin() const  { return Iterator(text, delimiter); }
+    Iterator end() const    { return Iterator(); }
+
+    /* Field at index, an empty view past the end; walks the fields before it */
+    StringView nth(size_t index) const;
+    size_t count() const;
+
+private:
+    SplitRange(StringView text, Delimiter delimiter) : text(text), delimiter(delimiter) {}
+
+    StringView  text;
+    Delimiter   delimiter;
+    friend StringView;
+};
+
+inline SplitRange StringView::split(char delimiter) const {
+    return SplitRange(*this, { SplitRange::Mode::Character, delimiter, StringView() });
+}
+
+inline SplitRange StringView::split(StringView delimiter) const {
+    return SplitRange(*this, { SplitRange::Mode::Sequence, '\0', delimiter });
+}
+
+inline SplitRange StringView::split_any(StringView set) const {
+    return SplitRange(*this, { SplitRange::Mode::AnyOf, '\0', set });
+}
+
+inline SplitRange StringView::lines() const {
+    return SplitRange(*this, { SplitRange::Mode::Lines, '\n', StringView() });
+}
+
+inline StringView SplitRange::nth(size_t index) const {
+    for(StringView field : *this)
+        if(index-- == 0) return field;
+    return StringView();
+}
+
+inline size_t SplitRange::count() const {
+    size_t total = 0;
+    for(Iterator itr = begin(); itr != end(); itr++) total++;
+    return total;
+}
+
+template<typename T>
+bool StringView::try_parse(T& out) const {
+    static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, "try_parse reads integers and floating point values");
+    T value{};
+    std::from_chars_result result = std::from_chars(ptr, ptr + size, value);
+    if(result.ec != std::errc() || result.ptr != ptr + size || size == 0) return false;
+    out = value;
+    return true;
+}
+
+inline size_t StringView::find(char character, size_t pos) const {
+    if(pos >= size) return npos;
+    size_t where = search::find_char(ptr + pos, size - pos, character);
+    return where != npos ? pos + where : npos;
+}
+
+inline size_t StringView::find(StringView str, size_t pos) const {
+    if(pos > size) return npos;
+    size_t where = search::find(ptr + pos, size - pos, str.ptr, str.size);
+    return where != npos ? pos + where : npos;
+}
+
+inline size_t StringView::find_first_of(StringView set, size_t pos) const {
+    if(pos >= size) return npos;
+    size_t where = search::find_first_of(ptr + pos, size - pos, set.ptr, set.size);
+    return where != npos ? pos + where : npos;
+}
+
+}
+
+namespace std {
+    template <>
+    struct hash<gdamn::data::StringView> {
+        size_t operator()(gdamn::data::StringView str) const {
+            return gdamn::data::hash_bytes(str.data(), str.len());
+        }
+    };
+}
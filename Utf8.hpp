@@ -0,0 +1,284 @@
+#pragma once
+#include <bit>
+#include <cstring>
+#include <cstdint>
+#include "StringView.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/*
+ * UTF-8 validation, counting and decoding over byte strings.
+ * With AVX2 the validator is the lookup-table algorithm of Keiser & Lemire ("Validating UTF-8 In Less Than One
+ * Instruction Per Byte"): three nibble lookups classify every byte pair 32 at a time and the errors are OR-ed into
+ * one register. Without AVX2 it is a scalar decoder that skips 16 byte ASCII runs with SSE2 (8 bytes elsewhere).
+ */
+namespace gdamn::data::utf8 {
+
+inline constexpr char32_t replacement = 0xFFFD;
+
+namespace scalar {
+
+/* Well-formed sequences as in the Unicode standard, table 3-7 */
+inline bool is_valid(const unsigned char* data, size_t count) {
+    size_t i = 0;
+    while(i < count) {
+#if defined(__SSE2__)
+        while(i + 16 <= count && _mm_movemask_epi8(_mm_loadu_si128((const __m128i*)(data + i))) == 0) i += 16;
+#else
+        for(uint64_t word; i + 8 <= count; i += 8) {
+            std::memcpy(&word, data + i, 8);
+            if(word & 0x8080808080808080ull) break;
+        }
+#endif
+        if(i >= count) break;
+
+        unsigned char lead = data[i];
+        if(lead < 0x80) { i++; continue; }
+
+        size_t extra;
+        unsigned char low = 0x80, high = 0xBF; /* Allowed range of the second byte */
+        if(lead >= 0xC2 && lead <= 0xDF)        extra = 1;
+        else if(lead >= 0xE0 && lead <= 0xEF) { extra = 2; if(lead == 0xE0) low = 0xA0; if(lead == 0xED) high = 0x9F; }
+        else if(lead >= 0xF0 && lead <= 0xF4) { extra = 3; if(lead == 0xF0) low = 0x90; if(lead == 0xF4) high = 0x8F; }
+        else return false;
+
+        if(count - i <= extra) return false;
+        if(data[i + 1] < low || data[i + 1] > high) return false;
+        for(size_t k = 2; k <= extra; k++)
+            if((data[i + k] & 0xC0) != 0x80) return false;
+        i += extra + 1;
+    }
+    return true;
+}
+
+}
+
+#if defined(__AVX2__)
+namespace avx2 {
+
+/* Error bits, a byte pair is invalid when one bit is set in all three lookups */
+inline constexpr uint8_t too_short  = 1 << 0; /* Lead not followed by a continuation */
+inline constexpr uint8_t too_long   = 1 << 1; /* ASCII followed by a continuation */
+inline constexpr uint8_t overlong_3 = 1 << 2;
+inline constexpr uint8_t too_large  = 1 << 3;
+inline constexpr uint8_t surrogate  = 1 << 4;
+inline constexpr uint8_t overlong_2 = 1 << 5;
+inline constexpr uint8_t too_large_1000 = 1 << 6;
+inline constexpr uint8_t overlong_4 = 1 << 6;
+inline constexpr uint8_t two_conts  = 1 << 7; /* Continuation following a continuation, fine inside 3/4 byte sequences */
+inline constexpr uint8_t carry      = too_short | too_long | two_conts;
+
+inline __m256i lookup(__m256i nibbles, const uint8_t (&table)[16]) {
+    __m128i half = _mm_loadu_si128((const __m128i*)table);
+    return _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(half), nibbles);
+}
+
+inline __m256i high_nibbles(__m256i bytes) {
+    return _mm256_and_si256(_mm256_srli_epi16(bytes, 4), _mm256_set1_epi8(0x0F));
+}
+
+/* input shifted right by n bytes with the last n bytes of previous shifted in */
+template<int n>
+inline __m256i prev(__m256i input, __m256i previous) {
+    return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(previous, input, 0x21), 16 - n);
+}
+
+inline __m256i check_block(__m256i input, __m256i previous) {
+    static constexpr uint8_t byte_1_high[16] = {
+        too_long, too_long, too_long, too_long, too_long, too_long, too_long, too_long,
+        two_conts, two_conts, two_conts, two_conts,
+        too_short | overlong_2,
+        too_short,
+        too_short | overlong_3 | surrogate,
+        too_short | too_large | too_large_1000 | overlong_4
+    };
+    static constexpr uint8_t byte_1_low[16] = {
+        carry | overlong_3 | overlong_2 | overlong_4,
+        carry | overlong_2,
+        carry, carry,
+        carry | too_large,
+        carry | too_large | too_large_1000, carry | too_large | too_large_1000, carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000, carry | too_large | too_large_1000, carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000, carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000 | surrogate,
+        carry | too_large | too_large_1000, carry | too_large | too_large_1000
+    };
+    static constexpr uint8_t byte_2_high[16] = {
+        too_short, too_short, too_short, too_short, too_short, too_short, too_short, too_short,
+        too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4,
+        too_long | overlong_2 | two_conts | overlong_3 | too_large,
+        too_long | overlong_2 | two_conts | surrogate | too_large,
+        too_long | overlong_2 | two_conts | surrogate | too_large,
+        too_short, too_short, too_short, too_short
+    };
+
+    __m256i prev1 = prev<1>(input, previous);
+    __m256i special = _mm256_and_si256(
+        _mm256_and_si256(lookup(high_nibbles(prev1), byte_1_high),
+                         lookup(_mm256_and_si256(prev1, _mm256_set1_epi8(0x0F)), byte_1_low)),
+        lookup(high_nibbles(input), byte_2_high));
+
+    /* Third and fourth bytes of 3/4 byte sequences have to be continuations, exactly where two_conts fired */
+    __m256i third = _mm256_subs_epu8(prev<2>(input, previous), _mm256_set1_epi8((char)(0xE0 - 1)));
+    __m256i fourth = _mm256_subs_epu8(prev<3>(input, previous), _mm256_set1_epi8((char)(0xF0 - 1)));
+    __m256i must_continue = _mm256_cmpgt_epi8(_mm256_or_si256(third, fourth), _mm256_setzero_si256());
+    /* cmpgt is signed, saturated results are at most 0x1F/0x0F so they stay positive */
+    return _mm256_xor_si256(_mm256_and_si256(must_continue, _mm256_set1_epi8((char)0x80)), special);
+}
+
+/* Non-zero where the block ends inside a sequence that the next block has to finish */
+inline __m256i incomplete(__m256i input) {
+    static constexpr uint8_t max_value[32] = {
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        0xF0 - 1, 0xE0 - 1, 0xC0 - 1
+    };
+    return _mm256_subs_epu8(input, _mm256_loadu_si256((const __m256i*)max_value));
+}
+
+inline bool is_valid(const unsigned char* data, size_t count) {
+    __m256i error = _mm256_setzero_si256();
+    __m256i previous = _mm256_setzero_si256();
+    __m256i previous_incomplete = _mm256_setzero_si256();
+
+    auto step = [&](__m256i input) {
+        if(_mm256_movemask_epi8(input) == 0) { /* ASCII block, only a sequence cut off by the last block can be wrong */
+            error = _mm256_or_si256(error, previous_incomplete);
+            previous_incomplete = _mm256_setzero_si256();
+        } else {
+            error = _mm256_or_si256(error, check_block(input, previous));
+            previous_incomplete = incomplete(input);
+        }
+        previous = input;
+    };
+
+    size_t i = 0;
+    for(; i + 32 <= count; i += 32) {
+        step(_mm256_loadu_si256((const __m256i*)(data + i)));
+        if((i & 1023) == 0 && !_mm256_testz_si256(error, error)) return false; /* Bail out early on garbage */
+    }
+
+    /* The tail is zero padded, which also catches a sequence left unfinished at the very end */
+    alignas(32) unsigned char tail[32] = {};
+    if(count > i) std::memcpy(tail, data + i, count - i);
+    step(_mm256_load_si256((const __m256i*)tail));
+    error = _mm256_or_si256(error, previous_incomplete);
+    return _mm256_testz_si256(error, error);
+}
+
+}
+#endif
+
+inline bool is_valid(StringView str) {
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(str.data());
+#if defined(__AVX2__)
+    return avx2::is_valid(data, str.len());
+#else
+    return scalar::is_valid(data, str.len());
+#endif
+}
+
+/* Code points in valid UTF-8, i.e. the bytes that aren't continuations (10xxxxxx) */
+inline size_t length(StringView str) {
+    const char* data = str.data();
+    const size_t count = str.len();
+    size_t total = 0;
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i limit32 = _mm256_set1_epi8((char)0xBF);
+    for(; i + 32 <= count; i += 32) {
+        __m256i block = _mm256_loadu_si256((const __m256i*)(data + i));
+        total += std::popcount((uint32_t)_mm256_movemask_epi8(_mm256_cmpgt_epi8(block, limit32)));
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128i limit16 = _mm_set1_epi8((char)0xBF);
+    for(; i + 16 <= count; i += 16) {
+        __m128i block = _mm_loadu_si128((const __m128i*)(data + i));
+        total += std::popcount((uint32_t)_mm_movemask_epi8(_mm_cmpgt_epi8(block, limit16)));
+    }
+#endif
+    for(; i < count; i++) total += (signed char)data[i] > (signed char)0xBF;
+    return total;
+}
+
+/*
+ * Decodes the code point at itr and moves itr past it. Ill-formed input gives U+FFFD and skips a single byte,
+ * so decoding always makes progress.
+ */
+inline char32_t decode(const char*& itr, const char* end) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(itr);
+    unsigned char lead = bytes[0];
+    if(lead < 0x80) { itr++; return lead; }
+
+    size_t available = (size_t)(end - itr);
+    size_t extra;
+    unsigned char low = 0x80, high = 0xBF;
+    char32_t point;
+    if(lead >= 0xC2 && lead <= 0xDF)        { extra = 1; point = lead & 0x1F; }
+    else if(lead >= 0xE0 && lead <= 0xEF)   { extra = 2; point = lead & 0x0F; if(lead == 0xE0) low = 0xA0; if(lead == 0xED) high = 0x9F; }
+    else if(lead >= 0xF0 && lead <= 0xF4)   { extra = 3; point = lead & 0x07; if(lead == 0xF0) low = 0x90; if(lead == 0xF4) high = 0x8F; }
+    else { itr++; return replacement; }
+
+    if(available <= extra || bytes[1] < low || bytes[1] > high) { itr++; return replacement; }
+    for(size_t k = 1; k <= extra; k++) {
+        if(k > 1 && (bytes[k] & 0xC0) != 0x80) { itr++; return replacement; }
+        point = (point << 6) | (bytes[k] & 0x3F);
+    }
+    itr += extra + 1;
+    return point;
+}
+
+/* Forward range of the code points in a byte string, see decode() for how ill-formed bytes are reported */
+class CodePoints {
+public:
+    class Iterator {
+    public:
+        Iterator() {}
+        Iterator(const char* itr, const char* end) : itr(itr), end(end) { load(); }
+
+        Iterator& operator++() {
+            load();
+            return *this;
+        }
+
+        Iterator& operator++(int) {
+            load();
+            return *this;
+        }
+
+        bool operator==(const Iterator& other) const { return current == other.current; }
+        bool operator!=(const Iterator& other) const { return current != other.current; }
+
+        char32_t operator*() const { return point; }
+
+    private:
+        void load() {
+            current = itr;
+            if(itr != end) point = decode(itr, end);
+        }
+
+        const char* current = nullptr;  /* Start of the code point being looked at */
+        const char* itr = nullptr;      /* Start of the next one */
+        const char* end = nullptr;
+        char32_t    point = 0;
+    };
+
+    explicit CodePoints(StringView str) : str(str) {}
+
+    Iterator begin() const { return Iterator(str.data(), str.data() + str.len()); }
+    Iterator end() const   { return Iterator(str.data() + str.len(), str.data() + str.len()); }
+
+private:
+    StringView str;
+};
+
+inline CodePoints code_points(StringView str) {
+    return CodePoints(str);
+}
+
+}
@@ -2,16 +2,25 @@
 #include <initializer_list>
 #include <cstring>
 #include <limits>
-#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "Concepts.hpp"
 
 namespace gdamn::data {
 
+template<typename T>
+class Enumerable; /* Enumerable.hpp includes this file */
+
 template<typename T, typename alloc = std::allocator<T>>
 class Vector {
 public:
 
     class Iterator {
     public:
+        Iterator() : start(nullptr) {}
+
         Iterator(T* ptr) {
             start = ptr;
         }
@@ -64,23 +73,30 @@ public:
     private:
         T* start;
         size_t advance = 0;
-        friend Vector<T>;
+        friend Vector<T, alloc>;
     };
 
     Vector();
     explicit Vector(size_t n); /* Make sure all integral types besides size_t are not accepted into this constructor */
-    Vector(T item);
+    Vector(T item) requires (!std::is_same_v<T, size_t>); /* Vector<size_t>(n) reserves, like the constructor above */
     Vector(std::initializer_list<T> items);
     Vector(Vector&& other);
-    Vector(Vector&);
+    Vector(const Vector&);
     ~Vector();
 
-    void realign(size_t n);
-    void for_each(std::function<void(T&)> call_back);
-    auto where(std::function<bool(T&)> match_func);
+    Vector& operator=(Vector&& other);
+    Vector& operator=(const Vector& other);
+
+    void realign(size_t n); /* Grows the reserve by n */
+    template<Visitor<T&> F>
+    void for_each(F call_back);
+    template<Predicate<const T&> F>
+    Enumerable<T> where(F match_func); /* Needs Enumerable.hpp where it's called */
 
     void insert(T& item); // Return iterator
     void insert(T&& item);
+    template<typename... Args>
+    T& emplace_back(Args&&... args);
     
     size_t find(T& key); // Return iterator
     size_t find(T&& key);
@@ -91,6 +107,7 @@ public:
     void remove(T& item);
     void remove(T&& item);
     void remove(Vector<T, alloc>::Iterator& pos);
+    void clear();
 
     inline const size_t len() const;
     inline size_t available_reserve() const;
@@ -98,50 +115,56 @@ public:
     auto end();
     T& first() { return sub_data[0]; }
     T& last() { return sub_data[length - 1]; }
+    T* data() { return sub_data; }
+    const T* data() const { return sub_data; }
 
     T& operator[](size_t i);
+    const T& operator[](size_t i) const { return sub_data[i]; }
 private:
-    T* sub_data;
+    void erase_at(size_t i);
+    static void relocate(T* dst, T* src, size_t count);
+
+    T* sub_data = nullptr;
     size_t length = 0;
     size_t n_reserve = 0;
     alloc allocator;
 };
 
+/* Moves count elements into uninitialized dst and ends their lifetime in src */
 template<typename T, typename alloc>
-Vector<T, alloc>::Vector() {
-    sub_data = allocator.allocate(1);
-    n_reserve = 1;
-    length = 0;
+void Vector<T, alloc>::relocate(T* dst, T* src, size_t count) {
+    if constexpr(std::is_trivially_copyable_v<T>) {
+        if(count != 0) std::memcpy((void*)dst, (const void*)src, sizeof(T) * count);
+    } else {
+        for(size_t i = 0; i < count; i++) {
+            new (dst + i) T(std::move(src[i]));
+            src[i].~T();
+        }
+    }
 }
 
+template<typename T, typename alloc>
+Vector<T, alloc>::Vector() {}
+
 template<typename T, typename alloc>
 Vector<T, alloc>::Vector(size_t n) {
-    sub_data = allocator.allocate(n);
-    n_reserve = n;
+    realign(n);
 }
 
 template<typename T, typename alloc>
-Vector<T, alloc>::Vector(T item) {
-    sub_data = allocator.allocate(1);
-    sub_data[0] = item;
-    length++;
+Vector<T, alloc>::Vector(T item) requires (!std::is_same_v<T, size_t>) {
+    realign(1);
+    insert(std::move(item));
 }
 
 template<typename T, typename alloc>
 Vector<T, alloc>::Vector(const std::initializer_list<T> items) {
-    length = items.size();
-    sub_data = allocator.allocate(length);
-    size_t i = 0;
-
-    for(const auto& item : items) {
-        sub_data[i] = item;
-        i++;
-    }
+    realign(items.size());
+    for(const auto& item : items) emplace_back(item);
 }
 
 template<typename T, typename alloc>
 Vector<T, alloc>::Vector(Vector&& other) {
-    allocator.deallocate(sub_data, length + n_reserve);
     this->sub_data = other.sub_data;
     this->length = other.length;
     this->n_reserve = other.n_reserve;
@@ -150,47 +173,99 @@ Vector<T, alloc>::Vector(Vector&& other) {
     other.n_reserve = 0;
 }
 
+template<typename T, typename alloc>
+Vector<T, alloc>::Vector(const Vector& other) {
+    realign(other.length);
+    for(size_t i = 0; i < other.length; i++) emplace_back(other.sub_data[i]);
+}
+
+template<typename T, typename alloc>
+Vector<T, alloc>& Vector<T, alloc>::operator=(Vector&& other) {
+    if(this == &other) return *this;
+    this->~Vector();
+    this->sub_data = other.sub_data;
+    this->length = other.length;
+    this->n_reserve = other.n_reserve;
+    other.sub_data = nullptr;
+    other.length = 0;
+    other.n_reserve = 0;
+    return *this;
+}
+
+template<typename T, typename alloc>
+Vector<T, alloc>& Vector<T, alloc>::operator=(const Vector& other) {
+    if(this == &other) return *this;
+    clear();
+    if(other.length > n_reserve) realign(other.length - n_reserve);
+    for(size_t i = 0; i < other.length; i++) emplace_back(other.sub_data[i]);
+    return *this;
+}
+
 template<typename T, typename alloc>
 Vector<T, alloc>::~Vector() {
     for(size_t i = 0; i < length; i++)
         sub_data[i].~T();
-    allocator.deallocate(sub_data, length + n_reserve);
+    if(sub_data != nullptr) allocator.deallocate(sub_data, length + n_reserve);
 }
 
 template<typename T, typename alloc>
 void Vector<T, alloc>::realign(size_t n) {
+    if(n == 0) return;
     T* new_buffer = allocator.allocate(length + n_reserve + n);
-    std::memcpy(new_buffer, sub_data, sizeof(sub_data));
-    allocator.deallocate(sub_data, length + n_reserve);
+    if(sub_data != nullptr) {
+        relocate(new_buffer, sub_data, length);
+        allocator.deallocate(sub_data, length + n_reserve);
+    }
     sub_data = new_buffer;
     n_reserve += n;
 }
 
 template<typename T, typename alloc>
-void Vector<T, alloc>::for_each(std::function<void(T&)> call_back) {
+template<Visitor<T&> F>
+void Vector<T, alloc>::for_each(F call_back) {
     for(auto& val : *this) call_back(val);
 }
 
 template<typename T, typename alloc>
-auto Vector<T, alloc>::where(std::function<bool(T&)> match_func) {
-    // Enumerable<T> enumerable;
-    // for(auto& x : *this) if(match_func(x)) enumerable.insert(x);
+template<Predicate<const T&> F>
+Enumerable<T> Vector<T, alloc>::where(F match_func) {
+    Enumerable<T> enumerable;
+    for(size_t i = 0; i < length; i++)
+        if(match_func(sub_data[i])) enumerable.insert(sub_data[i]);
+    return enumerable;
 }
 
 template<typename T, typename alloc>
 void Vector<T, alloc>::insert(T& item) {
-    if(n_reserve == 0) realign(1);
-    sub_data[length] = item;
-    length++;
-    n_reserve--; // Consumed reserved storage
+    emplace_back(item);
 }
 
 template<typename T, typename alloc>
 void Vector<T, alloc>::insert(T&& item) {
-    if(n_reserve == 0) realign(1);
-    sub_data[length] = std::move(item);
+    emplace_back(std::move(item));
+}
+
+template<typename T, typename alloc>
+template<typename... Args>
+T& Vector<T, alloc>::emplace_back(Args&&... args) {
+    T* item;
+    if(n_reserve == 0) {
+        /* Double the storage so appends stay amortized O(1). The new item is built before the old ones move, args may refer into them */
+        size_t grow = length < 4 ? 4 : length;
+        T* new_buffer = allocator.allocate(length + grow);
+        item = new (new_buffer + length) T(std::forward<Args>(args)...);
+        if(sub_data != nullptr) {
+            relocate(new_buffer, sub_data, length);
+            allocator.deallocate(sub_data, length);
+        }
+        sub_data = new_buffer;
+        n_reserve = grow;
+    } else {
+        item = new (sub_data + length) T(std::forward<Args>(args)...);
+    }
     length++;
     n_reserve--; // Consumed reserved storage
+    return *item;
 }
 
 template<typename T, typename alloc>
@@ -217,54 +292,44 @@ bool Vector<T, alloc>::contains(T&& item) {
     return find(item) != std::numeric_limits<size_t>::max();
 }
 
+/* Shifts the tail down over i, the freed slot goes back to the reserve */
+template<typename T, typename alloc>
+void Vector<T, alloc>::erase_at(size_t i) {
+    if constexpr(std::is_trivially_copyable_v<T>) {
+        std::memmove((void*)(sub_data + i), (const void*)(sub_data + i + 1), sizeof(T) * (length - i - 1));
+    } else {
+        for(size_t j = i; j + 1 < length; j++) sub_data[j] = std::move(sub_data[j + 1]);
+        sub_data[length - 1].~T();
+    }
+    length--;
+    n_reserve++;
+}
+
 template<typename T, typename alloc>
 void Vector<T, alloc>::remove(T& item) {
-#define nshift (length - i + 1)
     size_t i = find(item);
     if(i == std::numeric_limits<size_t>::max()) return;
-
-    T* new_buffer = allocator.allocate(length + n_reserve - 1);
-    std::memcpy(new_buffer, sub_data, sizeof(T) * i);
-    std::memcpy(new_buffer + i, sub_data + i + 1, sizeof(T) * (length - i - 1));
-    sub_data[i].~T();
-    allocator.deallocate(sub_data, length + n_reserve);
-
-    length--;
-    sub_data = new_buffer;
+    erase_at(i);
 }
 
 template<typename T, typename alloc>
 void Vector<T, alloc>::remove(T&& item) {
     size_t i = find(item);
     if(i == std::numeric_limits<size_t>::max()) return;
-
-    T* new_buffer = allocator.allocate(length + n_reserve - 1);
-    std::memcpy(new_buffer, sub_data, sizeof(T) * i);
-    std::memcpy(new_buffer + i, sub_data + i + 1, sizeof(T) * (length - i - 1));
-    sub_data[i].~T();
-    allocator.deallocate(sub_data, length + n_reserve);
-
-    length--;
-    sub_data = new_buffer;
+    erase_at(i);
 }
 
 template<typename T, typename alloc>
 void Vector<T, alloc>::remove(Vector<T, alloc>::Iterator& pos) {
     if(pos == end()) return;
-    auto index_shift = length - pos.advance + 1;
-    T* lower_bounds = allocator.allocate(pos.advance + 1);
-    T* upper_bounds = allocator.allocate(index_shift);
-    std::memcpy(lower_bounds, sub_data, sizeof(T) * (pos.advance + 1));
-    std::memcpy(upper_bounds, sub_data + (pos.advance + 1), sizeof(T) * index_shift);
-    allocator.deallocate(sub_data, length + n_reserve);
-
-    sub_data = allocator.allocate((length - 1) + n_reserve);
-    std::memcpy(sub_data, lower_bounds, sizeof(T) * (pos.advance + 1));
-    std::memcpy(sub_data + pos.advance, upper_bounds, sizeof(T) * index_shift);
+    erase_at((size_t)(pos.start + pos.advance - sub_data));
+}
 
-    length--;
-    allocator.deallocate(lower_bounds, pos.advance + 1);
-    allocator.deallocate(upper_bounds, index_shift);
+template<typename T, typename alloc>
+void Vector<T, alloc>::clear() {
+    for(size_t i = 0; i < length; i++) sub_data[i].~T();
+    n_reserve += length;
+    length = 0;
 }
 
 template<typename T, typename alloc>
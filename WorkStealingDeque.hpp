@@ -0,0 +1,138 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+namespace gdamn::data {
+
+/*
+ * Chase-Lev work-stealing deque (memory orders after Le et al., "Correct and Efficient Work-Stealing for Weak Memory Models").
+ * The owning thread pushes and pops at the bottom, any other thread may steal from the top.
+ * The ring doubles when full; retired rings are kept until destruction because a thief may still be reading one.
+ * Values are copied in and out with relaxed atomics, so T has to be trivially copyable (typically a pointer).
+ */
+template<typename T>
+class WorkStealingDeque {
+    static_assert(std::is_trivially_copyable_v<T>, "WorkStealingDeque stores trivially copyable values, e.g. task pointers");
+
+private:
+    struct Ring {
+        Ring(int64_t capacity) : capacity(capacity), mask(capacity - 1) {
+            slots = new std::atomic<T>[capacity];
+        }
+        ~Ring() { delete[] slots; }
+
+        T get(int64_t i)            { return slots[i & mask].load(std::memory_order_relaxed); }
+        void put(int64_t i, T val)  { slots[i & mask].store(val, std::memory_order_relaxed); }
+
+        int64_t             capacity;
+        int64_t             mask;
+        std::atomic<T>*     slots = nullptr;
+        Ring*               retired = nullptr;  /* Older, smaller ring this one replaced */
+    };
+
+public:
+    explicit WorkStealingDeque(int64_t capacity = 64); /* Rounded up to a power of two */
+    ~WorkStealingDeque();
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    /* Owner thread only */
+    void push(T val);
+    bool pop(T& out);
+
+    /* Any thread */
+    bool steal(T& out);
+
+    size_t len() const {
+        int64_t b = bottom.load(std::memory_order_relaxed);
+        int64_t t = top.load(std::memory_order_relaxed);
+        return b > t ? (size_t)(b - t) : 0;
+    }
+    bool empty() const { return len() == 0; }
+
+private:
+    Ring* grow(Ring* ring, int64_t b, int64_t t);
+
+    alignas(64) std::atomic<int64_t> top = 0;
+    alignas(64) std::atomic<int64_t> bottom = 0;
+    std::atomic<Ring*> ring;
+};
+
+template<typename T>
+WorkStealingDeque<T>::WorkStealingDeque(int64_t capacity) {
+    int64_t size = 2;
+    while(size < capacity) size *= 2;
+    ring.store(new Ring(size), std::memory_order_relaxed);
+}
+
+template<typename T>
+WorkStealingDeque<T>::~WorkStealingDeque() {
+    Ring* itr = ring.load(std::memory_order_relaxed);
+    while(itr != nullptr) {
+        Ring* del = itr;
+        itr = itr->retired;
+        delete del;
+    }
+}
+
+template<typename T>
+typename WorkStealingDeque<T>::Ring* WorkStealingDeque<T>::grow(Ring* old_ring, int64_t b, int64_t t) {
+    Ring* new_ring = new Ring(old_ring->capacity * 2);
+    for(int64_t i = t; i < b; i++) new_ring->put(i, old_ring->get(i));
+    new_ring->retired = old_ring;
+    ring.store(new_ring, std::memory_order_release);
+    return new_ring;
+}
+
+template<typename T>
+void WorkStealingDeque<T>::push(T val) {
+    int64_t b = bottom.load(std::memory_order_relaxed);
+    int64_t t = top.load(std::memory_order_acquire);
+    Ring* r = ring.load(std::memory_order_relaxed);
+
+    if(b - t > r->capacity - 1) r = grow(r, b, t);
+    r->put(b, val);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom.store(b + 1, std::memory_order_relaxed);
+}
+
+template<typename T>
+bool WorkStealingDeque<T>::pop(T& out) {
+    int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+    Ring* r = ring.load(std::memory_order_relaxed);
+    bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = top.load(std::memory_order_relaxed);
+
+    if(t > b) { /* Already empty */
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return false;
+    }
+
+    out = r->get(b);
+    if(t == b) { /* Last element, race the thieves for it */
+        bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return won;
+    }
+    return true;
+}
+
+template<typename T>
+bool WorkStealingDeque<T>::steal(T& out) {
+    int64_t t = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t b = bottom.load(std::memory_order_acquire);
+    if(t >= b) return false;
+
+    Ring* r = ring.load(std::memory_order_acquire);
+    T val = r->get(t);
+    if(!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        return false; /* Lost the race against the owner or another thief */
+    out = val;
+    return true;
+}
+
+}
@@ -4,12 +4,293 @@
 #include "Deque.hpp"
 #include "List.hpp"
 #include "HashTable.hpp"
+#include "MpscQueue.hpp"
+#include "String.hpp"
+#include "SpscRing.hpp"
+#include "MpmcQueue.hpp"
+#include "Scheduler.hpp"
 #include <string>
 #include <iostream>
+#include <thread>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+#include <cmath>
+#include <functional>
+#include <mutex>
+#include <pthread.h>
 
 using namespace gdamn::data;
 
-int main() {
+/* Counts heap allocations so the demo can show which operations don't allocate */
+static std::atomic<size_t> allocations = 0;
+
+void* operator new(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if(void* ptr = std::malloc(size == 0 ? 1 : size)) return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+
+/* Benchmarks, run with `main bench`. Sizes are kept small enough to finish in seconds on a laptop */
+using bench_clock = std::chrono::steady_clock;
+
+static double seconds_since(bench_clock::time_point start) {
+    return std::chrono::duration<double>(bench_clock::now() - start).count();
+}
+
+static uint64_t now_ns() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(bench_clock::now().time_since_epoch()).count();
+}
+
+static void pin(std::thread& thread, unsigned cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu % std::max(1u, std::thread::hardware_concurrency()), &set);
+    pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+}
+
+static void report_latency(const char* name, std::vector<uint64_t>& samples) {
+    std::sort(samples.begin(), samples.end());
+    std::cout << name << " hand-off latency p50: " << samples[samples.size() / 2] << " ns, p99: "
+              << samples[samples.size() * 99 / 100] << " ns" << std::endl;
+}
+
+/* Producer and consumer pinned to cpus 0 and 1; push/pop are whatever the queue calls them */
+template<typename Push, typename Pop>
+static void bench_pair(const char* name, size_t ops, Push push, Pop pop, size_t values_per_op = 1) {
+    auto start = bench_clock::now();
+    std::thread producer([&]() { for(uint64_t i = 0; i < ops; i++) push(i); });
+    std::thread consumer([&]() { for(size_t i = 0; i < ops; i++) pop(); });
+    pin(producer, 0);
+    pin(consumer, 1);
+    producer.join();
+    consumer.join();
+    std::cout << name << ": " << (uint64_t)(ops * values_per_op / seconds_since(start)) << " values/sec" << std::endl;
+}
+
+/* One value in flight at a time, so the time is the hand-off itself rather than queueing behind others */
+template<typename Push, typename Pop>
+static void bench_latency(const char* name, size_t samples, Push push, Pop pop) {
+    std::vector<uint64_t> latency(samples);
+    std::atomic<size_t> received = 0;
+    std::thread consumer([&]() {
+        for(size_t i = 0; i < samples; i++) {
+            uint64_t sent = pop();
+            latency[i] = now_ns() - sent;
+            received.store(i + 1, std::memory_order_release);
+            received.notify_one();
+        }
+    });
+    std::thread producer([&]() {
+        for(size_t i = 0; i < samples; i++) {
+            push(now_ns());
+            for(size_t seen; (seen = received.load(std::memory_order_acquire)) != i + 1;) received.wait(seen);
+        }
+    });
+    pin(producer, 0);
+    pin(consumer, 1);
+    producer.join();
+    consumer.join();
+    report_latency(name, latency);
+}
+
+/* Producers then consumers pinned to cpus 0, 1, 2...; ops values in total, split evenly over either side */
+template<typename Push, typename TryPop>
+static void bench_many(const char* name, size_t n_producers, size_t n_consumers, size_t ops, Push push, TryPop try_pop) {
+    std::vector<std::thread> threads;
+    auto start = bench_clock::now();
+    for(size_t p = 0; p < n_producers; p++)
+        threads.emplace_back([&, p]() { for(uint64_t i = p; i < ops; i += n_producers) push(i); });
+    for(size_t c = 0; c < n_consumers; c++)
+        threads.emplace_back([&, c]() {
+            for(size_t i = c; i < ops;)
+                if(try_pop()) i += n_consumers; else std::this_thread::yield();
+        });
+    for(size_t t = 0; t < threads.size(); t++) pin(threads[t], (unsigned)t);
+    for(auto& thread : threads) thread.join();
+    std::cout << name << " " << n_producers << "P/" << n_consumers << "C: "
+              << (uint64_t)(ops / seconds_since(start)) << " values/sec" << std::endl;
+}
+
+static void bench_queues() {
+    std::cout << ">>>>>>>>>>>>> QUEUES <<<<<<<<<<<<<<" << std::endl;
+    constexpr size_t ops = 2000000, samples = 20000;
+
+    auto spsc = std::make_unique<SpscRing<uint64_t, 4096>>();
+    bench_pair("SpscRing push/pop", ops, [&](uint64_t v) { spsc->push(v); }, [&]() { uint64_t v = 0; spsc->pop(v); return v; });
+
+    uint64_t batch_in[64] = {}, batch_out[64];
+    bench_pair("SpscRing try_push_n/try_pop_n x64", ops / 64,
+        [&](uint64_t) {
+            for(size_t done = 0; done < 64;)
+                if(size_t moved = spsc->try_push_n(batch_in + done, 64 - done)) done += moved; else std::this_thread::yield();
+        },
+        [&]() {
+            for(size_t done = 0; done < 64;)
+                if(size_t moved = spsc->try_pop_n(batch_out + done, 64 - done)) done += moved; else std::this_thread::yield();
+        }, 64);
+    bench_latency("SpscRing", samples, [&](uint64_t v) { spsc->push(v); }, [&]() { uint64_t v = 0; spsc->pop(v); return v; });
+
+    MpmcQueue<uint64_t> mpmc(4096);
+    bench_pair("MpmcQueue push/pop", ops, [&](uint64_t v) { mpmc.push(v); }, [&]() { uint64_t v = 0; mpmc.pop(v); return v; });
+    bench_latency("MpmcQueue", samples, [&](uint64_t v) { mpmc.push(v); }, [&]() { uint64_t v = 0; mpmc.pop(v); return v; });
+
+    /* Contended hand-off, against the mutex guarded Deque it replaces */
+    std::mutex deque_lock;
+    Deque<uint64_t> deque;
+    for(size_t threads : { 2, 4 }) {
+        bench_many("MpmcQueue push/try_pop", threads, threads, ops,
+            [&](uint64_t v) { mpmc.push(v); }, [&]() { uint64_t v; return mpmc.try_pop(v); });
+        bench_many("std::mutex + Deque insert_back/pop_front", threads, threads, ops,
+            [&](uint64_t v) { std::lock_guard<std::mutex> guard(deque_lock); deque.insert_back(v); },
+            [&]() {
+                std::lock_guard<std::mutex> guard(deque_lock);
+                if(deque.len() == 0) return false;
+                deque.pop_front();
+                return true;
+            });
+    }
+
+    /* Many producers into one consumer, against the mutex guarded List it replaces */
+    MpscQueue<uint64_t> mpsc;
+    bench_many("MpscQueue push/try_pop", 4, 1, ops, [&](uint64_t v) { mpsc.push(v); }, [&]() { uint64_t v; return mpsc.try_pop(v); });
+
+    std::mutex list_lock;
+    List<uint64_t> list;
+    bench_many("std::mutex + List insert/pop_front", 4, 1, ops,
+        [&](uint64_t v) { std::lock_guard<std::mutex> guard(list_lock); list.insert(v); },
+        [&]() {
+            std::lock_guard<std::mutex> guard(list_lock);
+            if(list.len() == 0) return false;
+            list.pop_front();
+            return true;
+        });
+}
+
+/* The same parallel_for on pools of 1, 2, 4... workers, plus the cost of an empty task */
+static void bench_scheduler() {
+    std::cout << ">>>>>>>>>>>>> SCHEDULER <<<<<<<<<<<<<<" << std::endl;
+    constexpr size_t elements = 1 << 24, grain = 1 << 14;
+    std::vector<double> input(elements);
+    for(size_t i = 0; i < elements; i++) input[i] = (double)i;
+
+    double single = 0.0;
+    unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+    for(unsigned workers = 1;; workers = std::min(workers * 2, hardware)) {
+        gdamn::system::Scheduler pool(workers);
+        std::atomic<uint64_t> checksum = 0;
+        auto start = bench_clock::now();
+        pool.parallel_for(0, elements, grain, [&](size_t lo, size_t hi) {
+            double acc = 0.0;
+            for(size_t i = lo; i < hi; i++) acc += std::sqrt(input[i]) * std::sin(input[i]);
+            checksum.fetch_add((uint64_t)std::fabs(acc), std::memory_order_relaxed);
+        });
+        double elapsed = seconds_since(start);
+        if(workers == 1) single = elapsed;
+        std::cout << "parallel_for, " << workers << " workers: " << elapsed * 1000.0 << " ms, speedup "
+                  << single / elapsed << "x (checksum " << checksum.load() << ")" << std::endl;
+
+        constexpr size_t tasks = 200000;
+        start = bench_clock::now();
+        pool.parallel_for(0, tasks, 1, [](size_t) {});
+        std::cout << "  empty tasks: " << (uint64_t)(tasks / seconds_since(start)) << " tasks/sec" << std::endl;
+        if(workers == hardware) break;
+    }
+}
+
+/* BasicString::append / StringView::parse against std::to_string, strtoll and strtod */
+static void bench_numbers() {
+    std::cout << ">>>>>>>>>>>>> NUMBERS <<<<<<<<<<<<<<" << std::endl;
+    constexpr size_t count = 1000000;
+    std::vector<int64_t> integers(count);
+    std::vector<double> doubles(count);
+    uint64_t seed = 88172645463325252ull;
+    for(size_t i = 0; i < count; i++) {
+        seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17;
+        integers[i] = (int64_t)(seed >> 20) - (int64_t)(1ull << 43);
+        doubles[i] = (double)(int64_t)(seed >> 11) / 1e6;
+    }
+
+    auto time = [](const char* name, auto&& body) {
+        size_t checksum = 0;
+        auto start = bench_clock::now();
+        for(size_t i = 0; i < count; i++) checksum += body(i);
+        double elapsed = seconds_since(start);
+        std::cout << name << ": " << elapsed * 1e9 / count << " ns/value (checksum " << checksum << ")" << std::endl;
+    };
+
+    time("format int64, BasicString::append", [&](size_t i) { String str; str.append(integers[i]); return str.len(); });
+    time("format int64, std::to_string     ", [&](size_t i) { return std::to_string(integers[i]).size(); });
+    time("format double, BasicString::append", [&](size_t i) { String str; str.append(doubles[i]); return str.len(); });
+    time("format double, std::to_string     ", [&](size_t i) { return std::to_string(doubles[i]).size(); });
+
+    /* Parse back the shortest round-trip text, the same input for both sides */
+    std::vector<String> int_text(count), double_text(count);
+    for(size_t i = 0; i < count; i++) {
+        int_text[i].append(integers[i]);
+        double_text[i].append(doubles[i]);
+    }
+    time("parse int64, StringView::parse", [&](size_t i) { return (size_t)int_text[i].view().parse<int64_t>(); });
+    time("parse int64, strtoll          ", [&](size_t i) { return (size_t)std::strtoll(int_text[i].c_str(), nullptr, 10); });
+    time("parse double, StringView::parse", [&](size_t i) { return (size_t)double_text[i].view().parse<double>(); });
+    time("parse double, strtod          ", [&](size_t i) { return (size_t)std::strtod(double_text[i].c_str(), nullptr); });
+}
+
+/* Container callbacks as template parameters against the std::function signature they used to take */
+static void bench_callbacks() {
+    std::cout << ">>>>>>>>>>>>> CALLBACKS <<<<<<<<<<<<<<" << std::endl;
+    constexpr size_t count = 1 << 22, rounds = 20;
+    Vector<int> values;
+    values.realign(count);
+    for(size_t i = 0; i < count; i++) values.insert((int)(i * 2654435761u >> 8));
+
+    auto time = [](const char* name, auto&& body) {
+        size_t checksum = 0;
+        auto start = bench_clock::now();
+        for(size_t r = 0; r < rounds; r++) checksum += body();
+        std::cout << name << ": " << seconds_since(start) * 1e9 / (count * rounds) << " ns/element (checksum "
+                  << checksum << ")" << std::endl;
+    };
+
+    /* What for_each/where did before: one indirect call per element */
+    auto for_each_function = [&](std::function<void(int&)> call_back) { for(auto& val : values) call_back(val); };
+    auto count_function = [&](std::function<bool(const int&)> match_func) {
+        size_t total = 0;
+        for(size_t i = 0; i < values.len(); i++) total += match_func(values[i]);
+        return total;
+    };
+
+    int64_t bias = 3;
+    time("for_each, template        ", [&]() { int64_t sum = 0; values.for_each([&](int& v) { sum += v ^ bias; }); return (size_t)sum; });
+    time("for_each, std::function   ", [&]() { int64_t sum = 0; for_each_function([&](int& v) { sum += v ^ bias; }); return (size_t)sum; });
+    time("where().len(), template   ", [&]() { return values.where([&](const int& v) { return (v & 7) == bias; }).len(); });
+    time("count_if, template        ", [&]() {
+        size_t total = 0;
+        values.for_each([&](int& v) { total += (v & 7) == bias; });
+        return total;
+    });
+    time("count_if, std::function   ", [&]() { return count_function([&](const int& v) { return (v & 7) == bias; }); });
+}
+
+static int run_benchmarks() {
+    bench_queues();
+    bench_scheduler();
+    bench_numbers();
+    bench_callbacks();
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if(argc > 1 && std::strcmp(argv[1], "bench") == 0) return run_benchmarks();
+
     char l_l = false;
     std::cout << "CHOOSE LINKEDLIST (L), VECTOR(V) OR ARRAY(A): ";
     std::cin >> l_l;
@@ -57,6 +338,13 @@ int main() {
         std::cout << "Index of 10: " << arr.find(10) << std::endl;
     }
 
+    /* size_t elements: Vector's reserve constructor takes a size_t too */
+    Vector<size_t> sizes(16);
+    for(size_t i = 0; i < 10; i++) sizes.insert(i);
+    Array<size_t, 3> indices = { 1, 2, 3 };
+    auto odd = indices.where([](const size_t& i) { return i % 2 == 1; });
+    std::cout << "size_t Vector length: " << sizes.len() << ", odd indices: " << odd.len() << std::endl;
+
     Deque<int> deque;
     
     for(int i = 0; i < 100; i++) deque.insert(i);
@@ -79,4 +367,36 @@ int main() {
     std::cout << "HELLO WORLD: " << ht[str] << std::endl;
     std::cout << "Items: " << ht.len() << std::endl;
     std::cout << "Contains 'HELLO WORLD': " << ht.contains("HELLO WORLD") << std::endl;
+
+    std::cout << ">>>>>>>>>>>>> DICTIONARY <<<<<<<<<<<<<<" << std::endl;
+    Dictionary dict;
+    dict["a key long enough to live on the heap, 45 b"] = "found";
+    size_t before = allocations.load();
+    bool found = dict.contains("a key long enough to live on the heap, 45 b");
+    found = found && dict["a key long enough to live on the heap, 45 b"] == "found";
+    size_t literal_allocations = allocations.load() - before;
+    std::cout << "Literal lookup found: " << found << ", allocations: " << literal_allocations << std::endl;
+    if(!found || literal_allocations != 0) return 1;
+
+    std::cout << ">>>>>>>>>>>>> MPSC QUEUE <<<<<<<<<<<<<<" << std::endl;
+    constexpr int n_producers = 4, per_producer = 100000;
+    MpscQueue<int> queue;
+    std::thread producers[n_producers];
+    for(int p = 0; p < n_producers; p++)
+        producers[p] = std::thread([&queue, p]() { for(int i = 0; i < per_producer; i++) queue.push(p * per_producer + i); });
+
+    /* Every producer's values have to come out complete and in the order it pushed them */
+    int expected[n_producers] = {};
+    bool in_order = true;
+    size_t consumed = 0;
+    while(consumed < (size_t)n_producers * per_producer) {
+        consumed += queue.drain([&](int& val) {
+            int p = val / per_producer;
+            in_order = in_order && val % per_producer == expected[p]++;
+        });
+    }
+    for(auto& producer : producers) producer.join();
+    for(int p = 0; p < n_producers; p++) in_order = in_order && expected[p] == per_producer;
+    std::cout << "Consumed: " << consumed << ", per producer FIFO: " << in_order << std::endl;
+    if(!in_order) return 1;
 }
\ No newline at end of file